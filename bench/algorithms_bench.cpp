@@ -0,0 +1,112 @@
+#include <execution/bulk.hpp>
+#include <execution/just.hpp>
+#include <execution/let_value.hpp>
+#include <execution/sequence.hpp>
+#include <execution/sync_wait.hpp>
+#include <execution/then.hpp>
+#include <execution/when_all.hpp>
+
+#include <allocations.hpp>
+#include <operation_report.hpp>
+#include <receiver.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+using namespace execution;
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename F>
+void run_connect_start(benchmark::State& state, F make_sender)
+{
+    auto const allocations = bench::allocation_count();
+
+    for (auto _: state) {
+        auto op = execution::connect(make_sender(), bench::receiver{});
+        execution::start(op);
+    }
+
+    bench::report_allocations(state, allocations);
+    bench::report_operation(state, bench::inspect(make_sender()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void just_then(benchmark::State& state)
+{
+    run_connect_start(state, [] {
+        return just(1) | then([] (int x) { return x + 1; });
+    });
+}
+
+void then_chain(benchmark::State& state)
+{
+    run_connect_start(state, [] {
+        auto inc = [] (int x) { return x + 1; };
+        return just(0)
+            | then(inc) | then(inc) | then(inc) | then(inc)
+            | then(inc) | then(inc) | then(inc) | then(inc);
+    });
+}
+
+void let_value_just(benchmark::State& state)
+{
+    run_connect_start(state, [] {
+        return just(1) | let_value([] (int x) { return just(x + 1); });
+    });
+}
+
+void when_all_just(benchmark::State& state)
+{
+    run_connect_start(state, [] {
+        return when_all(just(1), just(2.0), just('X'));
+    });
+}
+
+void sequence_just(benchmark::State& state)
+{
+    run_connect_start(state, [] {
+        return sequence(just(), just(), just(1));
+    });
+}
+
+void bulk_inline(benchmark::State& state)
+{
+    auto const shape = static_cast<int>(state.range(0));
+
+    std::vector<int> data(shape);
+
+    run_connect_start(state, [&] {
+        return just() | bulk(shape, [&] (int i) { data[i] += i; });
+    });
+
+    benchmark::DoNotOptimize(data.data());
+}
+
+void sync_wait_just(benchmark::State& state)
+{
+    auto const allocations = bench::allocation_count();
+
+    for (auto _: state) {
+        auto r = this_thread::sync_wait(just(1));
+        benchmark::DoNotOptimize(r);
+    }
+
+    bench::report_allocations(state, allocations);
+}
+
+}   // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+BENCHMARK(just_then);
+BENCHMARK(then_chain);
+BENCHMARK(let_value_just);
+BENCHMARK(when_all_just);
+BENCHMARK(sequence_just);
+BENCHMARK(bulk_inline)->Arg(16)->Arg(1024);
+BENCHMARK(sync_wait_just);
@@ -0,0 +1,80 @@
+#include <execution/ensure_started.hpp>
+#include <execution/just.hpp>
+#include <execution/monotonic_arena.hpp>
+#include <execution/slab_allocator.hpp>
+#include <execution/start_detached.hpp>
+#include <execution/sync_wait.hpp>
+#include <execution/then.hpp>
+#include <execution/when_all_range.hpp>
+
+#include <allocations.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+using namespace execution;
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename F>
+void run_with_allocator(benchmark::State& state, F make_allocator)
+{
+    int sum = 0;
+
+    // warm up thread-local caches
+    start_detached(just(0) | then([&] (int x) { sum += x; }), make_allocator());
+
+    auto const allocations = bench::allocation_count();
+
+    for (auto _: state) {
+        start_detached(just(1) | then([&] (int x) { sum += x; }), make_allocator());
+        auto [r] = *this_thread::sync_wait(ensure_started(just(2), make_allocator()));
+        sum += r;
+    }
+
+    benchmark::DoNotOptimize(sum);
+    bench::report_allocations(state, allocations);
+}
+
+void default_allocator(benchmark::State& state)
+{
+    run_with_allocator(state, [] { return std::allocator<std::byte>{}; });
+}
+
+void slab(benchmark::State& state)
+{
+    run_with_allocator(state, [] { return slab_allocator<std::byte>{}; });
+}
+
+void arena(benchmark::State& state)
+{
+    // one arena per "request", backed by a stack buffer
+    alignas(std::max_align_t) std::byte buffer[4096];
+
+    int sum = 0;
+    auto const allocations = bench::allocation_count();
+
+    for (auto _: state) {
+        monotonic_arena arena {buffer, sizeof(buffer)};
+        arena_allocator<std::byte> allocator {arena};
+
+        start_detached(just(1) | then([&] (int x) { sum += x; }), allocator);
+        auto [r] = *this_thread::sync_wait(ensure_started(just(2), allocator));
+        sum += r;
+    }
+
+    benchmark::DoNotOptimize(sum);
+    bench::report_allocations(state, allocations);
+}
+
+}   // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+BENCHMARK(default_allocator);
+BENCHMARK(slab);
+BENCHMARK(arena);
@@ -0,0 +1,99 @@
+#include <execution/any_sender.hpp>
+#include <execution/just.hpp>
+#include <execution/let_value.hpp>
+#include <execution/then.hpp>
+
+#include <allocations.hpp>
+#include <receiver.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+
+using namespace execution;
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// the same pipelines typed and erased: the difference is the cost of the
+// indirection (vtable calls, buffer management and heap fallback)
+
+template <typename F>
+void run_connect_start(benchmark::State& state, F make_sender)
+{
+    auto const allocations = bench::allocation_count();
+
+    for (auto _: state) {
+        auto op = execution::connect(make_sender(), bench::receiver{});
+        execution::start(op);
+    }
+
+    bench::report_allocations(state, allocations);
+}
+
+auto inc_chain()
+{
+    auto inc = [] (int x) { return x + 1; };
+    return just(0) | then(inc) | then(inc) | then(inc) | then(inc);
+}
+
+void then_typed(benchmark::State& state)
+{
+    run_connect_start(state, inc_chain);
+}
+
+void then_erased(benchmark::State& state)
+{
+    run_connect_start(state, [] {
+        return any_sender_of<signature<int>>{inc_chain()};
+    });
+}
+
+// operation state too large for the inline buffer
+void large_typed(benchmark::State& state)
+{
+    run_connect_start(state, [] {
+        return just(std::array<int, 32>{}) | then([] (auto const& a) { return a[0]; });
+    });
+}
+
+void large_erased(benchmark::State& state)
+{
+    run_connect_start(state, [] {
+        return any_sender_of<signature<int>>{
+            just(std::array<int, 32>{}) | then([] (auto const& a) { return a[0]; })
+        };
+    });
+}
+
+// successors of different types behind a single signature
+void let_value_typed(benchmark::State& state)
+{
+    run_connect_start(state, [] {
+        return just(1) | let_value([] (int x) { return just(x + 1); });
+    });
+}
+
+void let_value_erased(benchmark::State& state)
+{
+    run_connect_start(state, [] {
+        return just(1) | let_value([] (int x) -> any_sender_of<signature<int>> {
+            if (x & 1) {
+                return just(x + 1);
+            }
+            return just(x) | then([] (int y) { return y * 2; });
+        });
+    });
+}
+
+}   // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+BENCHMARK(then_typed);
+BENCHMARK(then_erased);
+BENCHMARK(large_typed);
+BENCHMARK(large_erased);
+BENCHMARK(let_value_typed);
+BENCHMARK(let_value_erased);
@@ -0,0 +1,118 @@
+#include "allocations.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::atomic<std::size_t> allocations = 0;
+
+void* allocate(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+
+    throw std::bad_alloc{};
+}
+
+void* allocate(std::size_t size, std::align_val_t alignment)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+
+    auto const align = static_cast<std::size_t>(alignment);
+    auto const padded = (size + align - 1) / align * align;
+
+    if (void* ptr = std::aligned_alloc(align, padded ? padded : align)) {
+        return ptr;
+    }
+
+    throw std::bad_alloc{};
+}
+
+}   // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+void* operator new (std::size_t size)
+{
+    return allocate(size);
+}
+
+void* operator new[] (std::size_t size)
+{
+    return allocate(size);
+}
+
+void* operator new (std::size_t size, std::align_val_t alignment)
+{
+    return allocate(size, alignment);
+}
+
+void* operator new[] (std::size_t size, std::align_val_t alignment)
+{
+    return allocate(size, alignment);
+}
+
+void operator delete (void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[] (void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete (void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[] (void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete (void* ptr, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[] (void* ptr, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete (void* ptr, std::size_t, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[] (void* ptr, std::size_t, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace bench {
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::size_t allocation_count() noexcept
+{
+    return allocations.load(std::memory_order_relaxed);
+}
+
+void report_allocations(benchmark::State& state, std::size_t start)
+{
+    state.counters["allocs/op"] = benchmark::Counter(
+        static_cast<double>(allocation_count() - start),
+        benchmark::Counter::kAvgIterations);
+}
+
+}   // namespace bench
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+
+namespace bench {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// number of calls to the global operator new made by the process so far
+std::size_t allocation_count() noexcept;
+
+// adds an "allocs/op" counter: allocations made since `start` per iteration
+void report_allocations(benchmark::State& state, std::size_t start);
+
+}   // namespace bench
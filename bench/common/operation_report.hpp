@@ -0,0 +1,148 @@
+#pragma once
+
+#include "allocations.hpp"
+
+#include <execution/sender_traits.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <ostream>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace bench {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// how deep template instances nest inside of T, e.g. then<then<just>>
+template <typename T>
+struct nesting_depth
+    : std::integral_constant<std::size_t, 0>
+{};
+
+template <template <typename ...> typename T, typename ... Ts>
+struct nesting_depth<T<Ts...>>
+    : std::integral_constant<std::size_t,
+        1 + std::max({std::size_t{0}, nesting_depth<Ts>::value...})>
+{};
+
+template <typename T>
+constexpr std::size_t nesting_depth_v = nesting_depth<T>::value;
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct operation_report
+{
+    std::size_t size = 0;
+    std::size_t alignment = 0;
+    std::size_t depth = 0;
+
+    // heap allocations made by connect()
+    std::size_t connect_allocations = 0;
+    // heap allocations made from start() up to the completion
+    std::size_t run_allocations = 0;
+
+    std::size_t allocations() const noexcept
+    {
+        return connect_allocations + run_allocations;
+    }
+};
+
+inline std::ostream& operator << (std::ostream& os, operation_report const& r)
+{
+    return os
+        << "size: " << r.size
+        << ", alignment: " << r.alignment
+        << ", depth: " << r.depth
+        << ", allocations: " << r.connect_allocations
+        << " (connect) + " << r.run_allocations << " (run)";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct completion_receiver
+{
+    std::atomic_flag* _done;
+
+    template <typename ... Ts>
+    void set_value(Ts&& ... values)
+    {
+        (benchmark::DoNotOptimize(values), ...);
+        complete();
+    }
+
+    template <typename E>
+    void set_error(E&&)
+    {
+        complete();
+    }
+
+    void set_stopped()
+    {
+        complete();
+    }
+
+    void complete()
+    {
+        _done->test_and_set(std::memory_order_release);
+    }
+};
+
+template <typename S>
+using operation_of_t = decltype(execution::connect(
+    std::declval<S>(),
+    std::declval<completion_receiver>()));
+
+// connects and runs `sender` to completion (possibly on another thread)
+// and reports the layout of its operation state and the number of
+// allocations made on the way. Allocations are counted process-wide, keep
+// other threads quiet while inspecting.
+template <typename S>
+operation_report inspect(S&& sender)
+{
+    using operation_t = operation_of_t<S>;
+
+    operation_report report {
+        .size = sizeof(operation_t),
+        .alignment = alignof(operation_t),
+        .depth = nesting_depth_v<operation_t>
+    };
+
+    std::atomic_flag done;
+
+    auto const before_connect = allocation_count();
+
+    operation_t op = execution::connect(
+        std::forward<S>(sender),
+        completion_receiver{&done});
+
+    auto const before_start = allocation_count();
+
+    execution::start(op);
+
+    while (!done.test(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+
+    auto const after = allocation_count();
+
+    report.connect_allocations = before_start - before_connect;
+    report.run_allocations = after - before_start;
+
+    return report;
+}
+
+// publishes the report as benchmark counters
+inline void report_operation(benchmark::State& state, operation_report const& r)
+{
+    state.counters["op_size"] = static_cast<double>(r.size);
+    state.counters["op_align"] = static_cast<double>(r.alignment);
+    state.counters["op_depth"] = static_cast<double>(r.depth);
+}
+
+}   // namespace bench
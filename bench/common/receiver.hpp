@@ -0,0 +1,32 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <exception>
+
+namespace bench {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// keeps the values alive so that the pipeline isn't optimized away
+struct receiver
+{
+    template <typename ... Ts>
+    void set_value(Ts&& ... values)
+    {
+        (benchmark::DoNotOptimize(values), ...);
+    }
+
+    template <typename E>
+    [[ noreturn ]] void set_error(E&&)
+    {
+        std::terminate();
+    }
+
+    [[ noreturn ]] void set_stopped()
+    {
+        std::terminate();
+    }
+};
+
+}   // namespace bench
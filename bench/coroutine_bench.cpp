@@ -0,0 +1,231 @@
+#include <execution/conditional.hpp>
+#include <execution/finally.hpp>
+#include <execution/just.hpp>
+#include <execution/let_value.hpp>
+#include <execution/repeat_effect_until.hpp>
+#include <execution/sequence.hpp>
+#include <execution/slab_allocator.hpp>
+#include <execution/sync_wait.hpp>
+#include <execution/task.hpp>
+#include <execution/upon_error.hpp>
+
+#include <allocations.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <span>
+#include <system_error>
+
+using namespace execution;
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// in-memory stand-in for a socket of echo_tcp: reads return a message until
+// `_messages` have been read, then the peer "disconnects"; all the i/o
+// completes inline so that only the cost of the control flow is measured
+struct fake_socket
+{
+    std::size_t _messages;
+    std::size_t _reads = 0;
+    std::size_t _written = 0;
+};
+
+template <typename R>
+struct read_operation
+{
+    R _receiver;
+    fake_socket* _socket;
+    std::span<std::byte> _buffer;
+
+    void start() & noexcept
+    {
+        auto const size = _socket->_reads++ < _socket->_messages
+            ? std::min<std::size_t>(_buffer.size(), 64)
+            : 0;
+
+        execution::set_value(std::move(_receiver), _buffer.first(size));
+    }
+};
+
+struct read_some
+{
+    template <typename R>
+    using operation_t = read_operation<std::decay_t<R>>;
+    using values_t = meta::list<signature<std::span<std::byte>>>;
+    using errors_t = meta::list<std::error_code>;
+
+    fake_socket* _socket;
+    std::span<std::byte> _buffer;
+
+    template <typename R>
+    auto connect(R&& receiver) -> operation_t<R>
+    {
+        return {std::forward<R>(receiver), _socket, _buffer};
+    }
+};
+
+template <typename R>
+struct write_operation
+{
+    R _receiver;
+    fake_socket* _socket;
+    std::size_t _size;
+
+    void start() & noexcept
+    {
+        _socket->_written += _size;
+        execution::set_value(std::move(_receiver));
+    }
+};
+
+struct write
+{
+    template <typename R>
+    using operation_t = write_operation<std::decay_t<R>>;
+    using values_t = meta::list<signature<>>;
+    using errors_t = meta::list<std::error_code>;
+
+    fake_socket* _socket;
+    std::span<std::byte const> _buffer;
+
+    template <typename R>
+    auto connect(R&& receiver) -> operation_t<R>
+    {
+        return {std::forward<R>(receiver), _socket, _buffer.size()};
+    }
+};
+
+constexpr auto prefix = std::span{">> ", 3};
+constexpr auto bye = std::span{"bye", 3};
+
+////////////////////////////////////////////////////////////////////////////////
+
+// connection::process of echo_tcp
+struct connection
+{
+    fake_socket* _socket;
+
+    std::array<std::byte, 4096> _buffer = {};
+    bool _done = false;
+
+    auto process()
+    {
+        return read_some{_socket, _buffer}
+            | let_value([this] (std::span<std::byte> buf) {
+                _done = buf.empty();
+                return conditional([this] { return _done; },
+                    write{_socket, as_bytes(bye)},
+                    sequence(
+                        write{_socket, as_bytes(prefix)},
+                        write{_socket, buf}
+                    ));
+            })
+            | repeat_effect_until([this] { return _done; })
+            | upon_error([] (auto) {})
+            | finally(just());
+    }
+};
+
+// the same loop written as a coroutine. The allocator of the frames isn't
+// inherited from the caller, so process passes its own down to process_loop
+template <typename A>
+task<> process_loop(
+    std::allocator_arg_t,
+    A,
+    fake_socket* socket,
+    std::span<std::byte> buffer)
+{
+    for (;;) {
+        auto buf = co_await read_some{socket, buffer};
+        if (buf.empty()) {
+            co_await write{socket, as_bytes(bye)};
+            break;
+        }
+        co_await write{socket, as_bytes(prefix)};
+        co_await write{socket, buf};
+    }
+}
+
+template <typename A>
+task<> process(
+    std::allocator_arg_t,
+    A allocator,
+    fake_socket* socket,
+    std::span<std::byte> buffer)
+{
+    try {
+        co_await process_loop(std::allocator_arg, allocator, socket, buffer);
+    } catch (...) {
+    }
+    co_await just();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename F>
+void run_connections(benchmark::State& state, F run)
+{
+    auto const messages = static_cast<std::size_t>(state.range(0));
+
+    // warm up thread-local caches
+    fake_socket warm_up {messages};
+    run(warm_up);
+
+    auto const allocations = bench::allocation_count();
+
+    for (auto _: state) {
+        fake_socket socket {messages};
+        run(socket);
+        benchmark::DoNotOptimize(socket._written);
+    }
+
+    state.SetItemsProcessed(state.iterations() * messages);
+    bench::report_allocations(state, allocations);
+}
+
+void echo_sender(benchmark::State& state)
+{
+    run_connections(state, [] (fake_socket& socket) {
+        connection conn {&socket};
+        this_thread::sync_wait(conn.process());
+    });
+}
+
+// frames from the global heap, as without an allocator
+void echo_coroutine(benchmark::State& state)
+{
+    run_connections(state, [] (fake_socket& socket) {
+        std::array<std::byte, 4096> buffer = {};
+        this_thread::sync_wait(process(
+            std::allocator_arg,
+            std::allocator<std::byte>{},
+            &socket,
+            buffer));
+    });
+}
+
+// both frames from the thread-local pool instead of the global heap
+void echo_coroutine_pooled(benchmark::State& state)
+{
+    run_connections(state, [] (fake_socket& socket) {
+        std::array<std::byte, 4096> buffer = {};
+        this_thread::sync_wait(process(
+            std::allocator_arg,
+            slab_allocator<std::byte>{},
+            &socket,
+            buffer));
+    });
+}
+
+}   // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+BENCHMARK(echo_sender)->Arg(1)->Arg(64);
+BENCHMARK(echo_coroutine)->Arg(1)->Arg(64);
+BENCHMARK(echo_coroutine_pooled)->Arg(1)->Arg(64);
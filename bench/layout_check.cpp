@@ -0,0 +1,136 @@
+#include <execution/any_sender.hpp>
+#include <execution/ensure_started.hpp>
+#include <execution/just.hpp>
+#include <execution/let_value.hpp>
+#include <execution/schedule.hpp>
+#include <execution/sequence.hpp>
+#include <execution/then.hpp>
+#include <execution/thread_pool.hpp>
+#include <execution/when_all.hpp>
+#include <execution/when_all_range.hpp>
+
+#include <operation_report.hpp>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace execution;
+
+// Budgets for operation state layout and allocations. They are meant to
+// fail when a change makes the operation states of common pipelines grow or
+// allocate: raise them deliberately, together with the change that needs it.
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST(layout, then_chain)
+{
+    auto inc = [] (int x) { return x + 1; };
+
+    auto r = bench::inspect(just(0)
+        | then(inc) | then(inc) | then(inc) | then(inc));
+
+    RecordProperty("report", testing::PrintToString(r));
+
+    EXPECT_LE(r.size, 48u) << r;
+    EXPECT_EQ(0u, r.allocations()) << r;
+}
+
+TEST(layout, let_value)
+{
+    auto r = bench::inspect(just(1)
+        | let_value([] (int x) { return just(x, 2); })
+        | let_value([] (int x, int y) { return just(x + y); }));
+
+    RecordProperty("report", testing::PrintToString(r));
+
+    EXPECT_LE(r.size, 88u) << r;
+    EXPECT_EQ(0u, r.allocations()) << r;
+}
+
+TEST(layout, when_all)
+{
+    auto r = bench::inspect(when_all(just(1), just(2.0), just('X')));
+
+    RecordProperty("report", testing::PrintToString(r));
+
+    EXPECT_LE(r.size, 176u) << r;
+    EXPECT_EQ(0u, r.allocations()) << r;
+}
+
+TEST(layout, sequence)
+{
+    auto r = bench::inspect(sequence(just(), just(), just(1)));
+
+    RecordProperty("report", testing::PrintToString(r));
+
+    EXPECT_LE(r.size, 40u) << r;
+    EXPECT_EQ(0u, r.allocations()) << r;
+}
+
+TEST(layout, thread_pool)
+{
+    thread_pool pool {1};
+
+    auto r = bench::inspect(schedule(pool.get_scheduler())
+        | then([] { return 42; }));
+
+    RecordProperty("report", testing::PrintToString(r));
+
+    EXPECT_LE(r.size, 48u) << r;
+    EXPECT_EQ(0u, r.allocations()) << r;
+}
+
+TEST(layout, when_all_range)
+{
+    auto r = bench::inspect(
+        when_all_range(std::vector{just(1), just(2), just(3)}));
+
+    RecordProperty("report", testing::PrintToString(r));
+
+    // one block for the child operations plus the result vector
+    EXPECT_LE(r.allocations(), 2u) << r;
+}
+
+TEST(layout, ensure_started)
+{
+    auto const before = bench::allocation_count();
+
+    // the shared state and the operation of the source are allocated when
+    // the sender is made, before inspect() counts anything
+    auto r = bench::inspect(ensure_started(just(1)));
+
+    auto const allocations = bench::allocation_count() - before;
+
+    RecordProperty("report", testing::PrintToString(r));
+
+    EXPECT_LE(r.size, 48u) << r;
+    EXPECT_EQ(0u, r.allocations()) << r;
+    EXPECT_EQ(2u, allocations) << r;
+}
+
+TEST(layout, any_sender)
+{
+    auto inc = [] (int x) { return x + 1; };
+
+    auto r = bench::inspect(any_sender_of<signature<int>>{
+        just(0) | then(inc) | then(inc)
+    });
+
+    RecordProperty("report", testing::PrintToString(r));
+
+    // small senders and their operation states stay inline
+    EXPECT_LE(r.size, 176u) << r;
+    EXPECT_EQ(0u, r.allocations()) << r;
+}
+
+TEST(layout, depth)
+{
+    using shallow_t = bench::operation_of_t<decltype(just(1))>;
+    using deep_t = bench::operation_of_t<decltype(just(1)
+        | then([] (int x) { return x; })
+        | then([] (int x) { return x; }))>;
+
+    static_assert(bench::nesting_depth_v<deep_t>
+        > bench::nesting_depth_v<shallow_t>);
+}
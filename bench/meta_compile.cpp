@@ -0,0 +1,107 @@
+// compile-time benchmark of the meta layer: instantiates wide and deep
+// sender graphs and does nothing at run time. Not built by default, time it
+// with
+//
+//   cmake --build <build-dir> --target meta_compile -- -B
+//
+// and scale the graphs with -DMETA_COMPILE_WIDTH=<n>
+
+#include <execution/just.hpp>
+#include <execution/let_value.hpp>
+#include <execution/null_receiver.hpp>
+#include <execution/then.hpp>
+#include <execution/upon_error.hpp>
+#include <execution/when_all.hpp>
+
+#include <exception>
+#include <type_traits>
+#include <utility>
+
+#ifndef META_COMPILE_WIDTH
+#define META_COMPILE_WIDTH 32
+#endif
+
+using namespace execution;
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <int i>
+using value_t = std::integral_constant<int, i>;
+
+template <typename Is>
+struct fan_out;
+
+// completes with one of `width` distinct value signatures
+template <int ... Is>
+struct fan_out<std::integer_sequence<int, Is...>>
+{
+    using values_t = meta::list<signature<value_t<Is>>...>;
+    using errors_t = meta::list<std::exception_ptr>;
+
+    template <typename R>
+    struct operation
+    {
+        R _receiver;
+
+        void start() & noexcept
+        {
+            execution::set_value(std::move(_receiver), value_t<0>{});
+        }
+    };
+
+    template <typename R>
+    using operation_t = operation<std::decay_t<R>>;
+
+    template <typename R>
+    auto connect(R&& receiver) -> operation_t<R>
+    {
+        return {std::forward<R>(receiver)};
+    }
+};
+
+constexpr int width = META_COMPILE_WIDTH;
+
+using wide_t = fan_out<std::make_integer_sequence<int, width>>;
+
+////////////////////////////////////////////////////////////////////////////////
+
+// let_value with a distinct successor type per predecessor value
+auto deep()
+{
+    return wide_t{}
+        | let_value([] <int i> (value_t<i>) {
+            return just(value_t<i>{}, value_t<i + 1>{});
+        })
+        | then([] <int i> (value_t<i>, value_t<i + 1>) {
+            return value_t<i * 2>{};
+        })
+        | upon_error([] (auto) {
+            return value_t<-1>{};
+        });
+}
+
+// when_all over `width` children of distinct types
+template <int ... Is>
+auto wide(std::integer_sequence<int, Is...>)
+{
+    return when_all(
+        (just(value_t<Is>{}) | then([] (auto v) { return value_t<v + 1>{}; }))...
+    );
+}
+
+}   // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+void meta_compile()
+{
+    auto d = connect(deep(), null_receiver{});
+    d.start();
+
+    auto w = connect(
+        wide(std::make_integer_sequence<int, width>{}),
+        null_receiver{});
+    w.start();
+}
@@ -0,0 +1,266 @@
+#include <execution/bulk.hpp>
+#include <execution/numa_thread_pool.hpp>
+#include <execution/run_loop.hpp>
+#include <execution/schedule.hpp>
+#include <execution/start_detached.hpp>
+#include <execution/sync_wait.hpp>
+#include <execution/then.hpp>
+#include <execution/thread_pool.hpp>
+#include <execution/timed_thread_pool.hpp>
+#include <execution/transfer_just.hpp>
+#include <execution/when_all_range.hpp>
+
+#include <allocations.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+using namespace execution;
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// a hop to the pool and back to the waiting thread
+template <typename P>
+void round_trip(benchmark::State& state)
+{
+    P pool {1};
+
+    auto sched = pool.get_scheduler();
+
+    auto const allocations = bench::allocation_count();
+
+    for (auto _: state) {
+        auto r = this_thread::sync_wait(schedule(sched));
+        benchmark::DoNotOptimize(r);
+    }
+
+    bench::report_allocations(state, allocations);
+}
+
+// round_trip with idle workers that spin up to range(0) times before
+// they park: 0 measures the cost of a futex wake per hop
+void ping_pong(benchmark::State& state)
+{
+    thread_pool pool {thread_pool_options{
+        .worker_count = 1,
+        .spin_limit = static_cast<std::uint32_t>(state.range(0)),
+    }};
+
+    auto sched = pool.get_scheduler();
+
+    for (auto _: state) {
+        auto r = this_thread::sync_wait(schedule(sched));
+        benchmark::DoNotOptimize(r);
+    }
+}
+
+void run_loop_schedule(benchmark::State& state)
+{
+    auto const tasks = state.range(0);
+
+    auto const allocations = bench::allocation_count();
+
+    for (auto _: state) {
+        run_loop loop;
+
+        auto sched = loop.get_scheduler();
+
+        std::int64_t count = 0;
+
+        for (std::int64_t i = 0; i != tasks; ++i) {
+            start_detached(schedule(sched) | then([&] {
+                if (++count == tasks) {
+                    loop.finish();
+                }
+            }));
+        }
+
+        loop.run();
+    }
+
+    state.SetItemsProcessed(state.iterations() * tasks);
+    bench::report_allocations(state, allocations);
+}
+
+// spread `tasks` senders over the pool and join them with when_all_range
+void fan_out_fan_in(benchmark::State& state)
+{
+    thread_pool pool {static_cast<std::size_t>(state.range(0))};
+
+    auto sched = pool.get_scheduler();
+    auto const tasks = state.range(1);
+
+    auto make = [&] (std::int64_t i) {
+        return schedule(sched) | then([i] { return i; });
+    };
+
+    using sender_t = decltype(make(0));
+
+    auto const allocations = bench::allocation_count();
+
+    for (auto _: state) {
+        std::vector<sender_t> senders;
+        senders.reserve(tasks);
+        for (std::int64_t i = 0; i != tasks; ++i) {
+            senders.push_back(make(i));
+        }
+
+        auto r = this_thread::sync_wait(when_all_range(std::move(senders)));
+        benchmark::DoNotOptimize(r);
+    }
+
+    state.SetItemsProcessed(state.iterations() * tasks);
+    bench::report_allocations(state, allocations);
+}
+
+// range(1) executions of one task, queued one by one or at once
+template <bool Batch>
+void fan_out_tasks(benchmark::State& state)
+{
+    struct counting_task
+        : task_base
+    {
+        std::atomic<std::int64_t> _remaining = 0;
+
+        counting_task()
+            : task_base {
+                ._execute = static_cast<task_base::execute_t>(&counting_task::execute)
+            }
+        {}
+
+        void execute()
+        {
+            if (_remaining.fetch_sub(1) == 1) {
+                _remaining.notify_one();
+            }
+        }
+    };
+
+    thread_pool pool {static_cast<std::size_t>(state.range(0))};
+
+    auto const tasks = state.range(1);
+
+    counting_task task;
+
+    for (auto _: state) {
+        task._remaining = tasks;
+
+        if constexpr (Batch) {
+            pool.schedule_n(&task, static_cast<std::size_t>(tasks));
+        } else {
+            for (std::int64_t i = 0; i != tasks; ++i) {
+                pool.schedule(&task);
+            }
+        }
+
+        for (auto n = task._remaining.load(); n; n = task._remaining.load()) {
+            task._remaining.wait(n);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * tasks);
+}
+
+void bulk_thread_pool(benchmark::State& state)
+{
+    thread_pool pool {static_cast<std::size_t>(state.range(0))};
+
+    auto sched = pool.get_scheduler();
+    auto const shape = state.range(1);
+
+    std::atomic<std::int64_t> sum = 0;
+
+    for (auto _: state) {
+        auto r = this_thread::sync_wait(
+            transfer_just(sched)
+                | bulk(shape, [&] (std::int64_t i) {
+                    sum.fetch_add(i, std::memory_order_relaxed);
+                }));
+        benchmark::DoNotOptimize(r);
+    }
+
+    state.SetItemsProcessed(state.iterations() * shape);
+}
+
+// every index writes and then sums its own slice of a buffer; the buffer is
+// first touched by a bulk of the same shape, so on numa_thread_pool its
+// pages are allocated on the node that reads them
+template <typename P>
+void bulk_bandwidth(benchmark::State& state)
+{
+    auto pool = [] {
+        if constexpr (std::is_same_v<P, numa_thread_pool>) {
+            return std::make_unique<P>();
+        } else {
+            return std::make_unique<P>(std::max(1u, std::thread::hardware_concurrency()));
+        }
+    } ();
+
+    auto sched = pool->get_scheduler();
+
+    std::size_t const slices = 256;
+    std::size_t const slice_size = static_cast<std::size_t>(state.range(0)) * 1024 / sizeof(double);
+
+    // not value-initialized: the pages are first touched by the bulk below
+    std::unique_ptr<double[]> data {new double[slices * slice_size]};
+    std::vector<double> sums(slices);
+
+    this_thread::sync_wait(
+        transfer_just(sched)
+            | bulk(slices, [&] (std::size_t i) {
+                std::fill_n(&data[i * slice_size], slice_size, 1.0);
+            }));
+
+    for (auto _: state) {
+        this_thread::sync_wait(
+            transfer_just(sched)
+                | bulk(slices, [&] (std::size_t i) {
+                    auto const* slice = &data[i * slice_size];
+                    sums[i] = std::accumulate(slice, slice + slice_size, 0.0);
+                }));
+        benchmark::DoNotOptimize(sums.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * slices * slice_size * sizeof(double));
+}
+
+}   // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+BENCHMARK(round_trip<thread_pool>)->UseRealTime();
+BENCHMARK(round_trip<timed_thread_pool>)->UseRealTime();
+BENCHMARK(ping_pong)->Arg(0)->Arg(adaptive_spin::default_limit)->UseRealTime();
+BENCHMARK(run_loop_schedule)->Arg(1)->Arg(64);
+
+BENCHMARK(fan_out_fan_in)
+    ->ArgsProduct({{1, 2, 4, 8}, {64}})
+    ->UseRealTime();
+
+BENCHMARK(fan_out_tasks<false>)
+    ->ArgsProduct({{1, 4}, {64}})
+    ->UseRealTime();
+
+BENCHMARK(fan_out_tasks<true>)
+    ->ArgsProduct({{1, 4}, {64}})
+    ->UseRealTime();
+
+BENCHMARK(bulk_thread_pool)
+    ->ArgsProduct({{1, 2, 4, 8}, {1024}})
+    ->UseRealTime();
+
+BENCHMARK(bulk_bandwidth<thread_pool>)->Arg(64)->Arg(1024)->UseRealTime();
+BENCHMARK(bulk_bandwidth<numa_thread_pool>)->Arg(64)->Arg(1024)->UseRealTime();
@@ -4,6 +4,7 @@
 #include <execution/let_value.hpp>
 #include <execution/repeat_effect_until.hpp>
 #include <execution/sequence.hpp>
+#include <execution/slab_allocator.hpp>
 #include <execution/start_detached.hpp>
 #include <execution/sync_wait.hpp>
 #include <execution/then.hpp>
@@ -144,13 +145,15 @@ int main(int argc, char** argv)
             | then([&] (int s, auto const& peer) {
                 std::clog << "new connection: " << to_string(peer) << '\n';
 
+                // connection states are recycled by the slab allocator
                 start_detached(just(connection{s})
                     | let_value([&] (connection& conn) {
                         return conn.process(ctx);
                     })
                     | then([=] {
                         std::clog << "done with " << to_string(peer) << '\n';
-                    })
+                    }),
+                    slab_allocator<std::byte>{}
                 );
               })
             | repeat_effect()
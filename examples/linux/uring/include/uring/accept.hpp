@@ -2,6 +2,8 @@
 
 #include "context.hpp"
 
+#include <execution/stop_token.hpp>
+
 #include <netinet/ip.h>
 
 #include <cassert>
@@ -44,8 +46,12 @@ struct operation
         sockaddr_in6 addr6;
     } _peer;
 
+    using stop_callback_t = execution::stop_callback_for_t<
+        execution::stop_token_of_t<R>,
+        cancel_callback>;
+
     socklen_t _peer_len;
-    std::optional<std::stop_callback<cancel_callback>> _stop_callback;
+    std::optional<stop_callback_t> _stop_callback;
 
     explicit operation(operation_descr<R>&& descr)
         : _receiver{std::move(descr._receiver)}
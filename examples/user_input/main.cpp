@@ -1,5 +1,6 @@
 #include "read_user_input.hpp"
 
+#include <execution/any_sender.hpp>
 #include <execution/just_stopped.hpp>
 #include <execution/just.hpp>
 #include <execution/let_value.hpp>
@@ -44,35 +45,39 @@ R"(commands:
 
 )";
 
+// every command is processed by a sender of the same type, so adding
+// a command doesn't add a successor operation to let_value
+using command_sender_t = any_sender_of<signature<>>;
+
 struct application
 {
     std::set<std::string> _objects;
 
-    auto process(commands::help)
+    command_sender_t process(commands::help)
     {
         std::cout << help_str;
 
         return just();
     }
 
-    auto process(commands::quit)
+    command_sender_t process(commands::quit)
     {
         return just_stopped();
     }
 
-    auto process(commands::create cmd)
+    command_sender_t process(commands::create cmd)
     {
         _objects.emplace(cmd._name);
         return just();
     }
 
-    auto process(commands::remove cmd)
+    command_sender_t process(commands::remove cmd)
     {
         _objects.erase(cmd._name);
         return just();
     }
 
-    auto process(commands::list)
+    command_sender_t process(commands::list)
     {
         std::cout << "{ ";
         for (auto& name: _objects) {
@@ -2,9 +2,13 @@
 
 #include "commands.hpp"
 
+#include <execution/async_blocking.hpp>
 #include <execution/sender_traits.hpp>
 
+#include <exception>
+#include <functional>
 #include <istream>
+#include <optional>
 #include <string>
 #include <system_error>
 
@@ -12,22 +16,89 @@ namespace read_user_input_impl {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+// blocks until a whole line is read; empty at the end of the stream
+struct get_line
+{
+    std::istream* _stream;
+
+    std::optional<std::string> operator () () const
+    {
+        std::string line;
+        if (!std::getline(*_stream, line)) {
+            return {};
+        }
+        return line;
+    }
+};
+
+using get_line_sender_t = decltype(execution::async_blocking(get_line{}));
+
+template <typename R>
+struct operation;
+
+template <typename R>
+struct line_receiver
+{
+    operation<R>* _op;
+
+    void set_value(std::optional<std::string> line)
+    {
+        _op->parse(std::move(line));
+    }
+
+    template <typename E>
+    void set_error(E&& error)
+    {
+        execution::set_error(std::move(_op->_receiver), std::forward<E>(error));
+    }
+
+    void set_stopped()
+    {
+        execution::set_stopped(std::move(_op->_receiver));
+    }
+
+    template <typename Tag, typename ... Ts>
+    friend auto tag_invoke(Tag tag, line_receiver const& self, Ts&& ... args)
+        noexcept(execution::is_nothrow_tag_invocable_v<Tag, R, Ts...>)
+        -> execution::tag_invoke_result_t<Tag, R, Ts...>
+    {
+        return std::invoke(tag, self._op->_receiver, std::forward<Ts>(args)...);
+    }
+};
+
 template <typename R>
 struct operation
 {
+    using get_line_operation_t = typename execution::sender_traits<
+        get_line_sender_t,
+        line_receiver<R>>::operation_t;
+
     R _receiver;
     std::istream* _stream;
+    std::optional<get_line_operation_t> _get_line;
 
+    // std::getline runs on the blocking pool; the line is parsed back on
+    // the scheduler of the receiver
     void start()
     {
-        std::string line;
-        if (!std::getline(*_stream, line)) {
+        auto& op = _get_line.emplace(execution::connect(
+            execution::async_blocking(get_line{_stream}),
+            line_receiver<R>{this}));
+
+        execution::start(op);
+    }
+
+    void parse(std::optional<std::string> input)
+    {
+        if (!input) {
             execution::set_error(
                 std::move(_receiver),
                 std::make_error_code(std::errc::io_error));
             return;
         }
 
+        auto const& line = *input;
+
         if (line == "quit" || line == "q") {
             execution::set_value(std::move(_receiver), commands::quit{});
             return;
@@ -80,7 +151,7 @@ struct sender
         signature<commands::create>,
         signature<commands::remove>
     >;
-    using errors_t = execution::meta::list<std::error_code>;
+    using errors_t = execution::meta::list<std::error_code, std::exception_ptr>;
 
     std::istream* _stream;
 
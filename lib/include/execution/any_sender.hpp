@@ -0,0 +1,447 @@
+#pragma once
+
+#include "inplace_stop_token.hpp"
+#include "sender_traits.hpp"
+#include "stop_token.hpp"
+
+#include <cstddef>
+#include <exception>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace execution {
+
+template <typename ... Sigs>
+class any_sender_of;
+
+template <typename ... Sigs>
+class any_receiver_of;
+
+namespace any_sender_impl {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// the sender and the operation state are kept inline when they fit, other
+// types go to the heap. Types that can throw on move are never stored
+// inline so that moving the owner stays noexcept
+constexpr std::size_t sender_inline_size = 4 * sizeof(void*);
+constexpr std::size_t operation_inline_size = 8 * sizeof(void*);
+
+template <std::size_t Size>
+class small_buffer
+{
+    alignas(std::max_align_t) std::byte _data[Size];
+
+public:
+    template <typename T>
+    static constexpr bool is_inline = sizeof(T) <= Size
+        && alignof(T) <= alignof(std::max_align_t)
+        && (std::is_nothrow_move_constructible_v<T>
+            || !std::is_move_constructible_v<T>);
+
+    // F returns a prvalue of T: operation states are constructed in place
+    template <typename T, typename F>
+    T& emplace_with(F&& factory)
+    {
+        if constexpr (is_inline<T>) {
+            return *::new (_data) T(std::forward<F>(factory)());
+        } else {
+            return **::new (_data) T*{new T(std::forward<F>(factory)())};
+        }
+    }
+
+    template <typename T>
+    T& get() noexcept
+    {
+        if constexpr (is_inline<T>) {
+            return *std::launder(reinterpret_cast<T*>(_data));
+        } else {
+            return **std::launder(reinterpret_cast<T**>(_data));
+        }
+    }
+
+    template <typename T>
+    void destroy() noexcept
+    {
+        if constexpr (is_inline<T>) {
+            get<T>().~T();
+        } else {
+            delete &get<T>();
+        }
+    }
+
+    // leaves this buffer empty
+    template <typename T>
+    void move_to(small_buffer& other) noexcept
+    {
+        if constexpr (is_inline<T>) {
+            ::new (other._data) T(std::move(get<T>()));
+            get<T>().~T();
+        } else {
+            ::new (other._data) T*{&get<T>()};
+        }
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// receiver vtable
+
+template <typename Sig>
+struct set_value_entry;
+
+template <typename ... Ts>
+struct set_value_entry<signature<Ts...>>
+{
+    void (*_set_value)(void*, Ts&& ...);
+
+    // by value: the overload set of all the signatures picks the entry
+    void set_value(void* receiver, Ts ... values) const
+    {
+        _set_value(receiver, std::move(values)...);
+    }
+
+    template <typename R>
+    static constexpr set_value_entry make() noexcept
+    {
+        return {[] (void* receiver, Ts&& ... values) {
+            execution::set_value(
+                std::move(*static_cast<R*>(receiver)),
+                std::move(values)...);
+        }};
+    }
+};
+
+template <typename ... Sigs>
+struct receiver_vtable
+    : set_value_entry<Sigs>...
+{
+    using set_value_entry<Sigs>::set_value...;
+
+    void (*_set_error)(void*, std::exception_ptr);
+    void (*_set_stopped)(void*);
+    inplace_stop_token (*_get_stop_token)(void const*) noexcept;
+};
+
+template <typename R, typename ... Sigs>
+inline constexpr receiver_vtable<Sigs...> receiver_vtable_for {
+    set_value_entry<Sigs>::template make<R>()...,
+    [] (void* receiver, std::exception_ptr error) {
+        execution::set_error(
+            std::move(*static_cast<R*>(receiver)),
+            std::move(error));
+    },
+    [] (void* receiver) {
+        execution::set_stopped(std::move(*static_cast<R*>(receiver)));
+    },
+    [] (void const* receiver) noexcept {
+        if constexpr (std::is_same_v<stop_token_of_t<R>, inplace_stop_token>) {
+            return execution::get_stop_token(*static_cast<R const*>(receiver));
+        } else {
+            (void)receiver;
+            return inplace_stop_token{};
+        }
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// sender vtable
+
+using operation_buffer_t = small_buffer<operation_inline_size>;
+using sender_buffer_t = small_buffer<sender_inline_size>;
+
+struct operation_vtable
+{
+    void (*_start)(operation_buffer_t&) noexcept;
+    void (*_destroy)(operation_buffer_t&) noexcept;
+};
+
+template <typename O>
+inline constexpr operation_vtable operation_vtable_for {
+    [] (operation_buffer_t& buffer) noexcept {
+        execution::start(buffer.template get<O>());
+    },
+    [] (operation_buffer_t& buffer) noexcept {
+        buffer.template destroy<O>();
+    }
+};
+
+template <typename ... Sigs>
+struct sender_vtable
+{
+    using receiver_t = any_receiver_of<Sigs...>;
+
+    void (*_move)(sender_buffer_t& from, sender_buffer_t& to) noexcept;
+    void (*_destroy)(sender_buffer_t&) noexcept;
+
+    // connects the sender (consuming it) into `operation`
+    operation_vtable const* (*_connect)(
+        sender_buffer_t& sender,
+        operation_buffer_t& operation,
+        receiver_t receiver);
+};
+
+template <typename S, typename ... Sigs>
+inline constexpr sender_vtable<Sigs...> sender_vtable_for {
+    [] (sender_buffer_t& from, sender_buffer_t& to) noexcept {
+        from.template move_to<S>(to);
+    },
+    [] (sender_buffer_t& sender) noexcept {
+        sender.template destroy<S>();
+    },
+    [] (
+        sender_buffer_t& sender,
+        operation_buffer_t& operation,
+        any_receiver_of<Sigs...> receiver) -> operation_vtable const*
+    {
+        using operation_t = decltype(execution::connect(
+            std::declval<S>(),
+            std::move(receiver)));
+
+        operation.template emplace_with<operation_t>([&] {
+            return execution::connect(
+                std::move(sender.template get<S>()),
+                std::move(receiver));
+        });
+
+        return &operation_vtable_for<operation_t>;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename R, typename ... Sigs>
+class operation
+{
+    struct forward_stop_request
+    {
+        inplace_stop_source* _stop_source;
+
+        void operator () () noexcept
+        {
+            _stop_source->request_stop();
+        }
+    };
+
+    using stop_callback_t = stop_callback_for_t<
+        stop_token_of_t<R>,
+        forward_stop_request>;
+
+    any_sender_of<Sigs...> _sender;
+    R _receiver;
+
+    inplace_stop_token _stop_token;
+    inplace_stop_source _stop_source;
+    std::optional<stop_callback_t> _stop_callback;
+
+    operation_vtable const* _vtable = nullptr;
+    operation_buffer_t _operation;
+
+public:
+    template <typename Rx>
+    operation(any_sender_of<Sigs...>&& sender, Rx&& receiver)
+        : _sender(std::move(sender))
+        , _receiver(std::forward<Rx>(receiver))
+    {}
+
+    // movable until started
+    operation(operation&& other)
+            noexcept(std::is_nothrow_move_constructible_v<R>)
+        : _sender(std::move(other._sender))
+        , _receiver(std::move(other._receiver))
+    {}
+
+    ~operation()
+    {
+        if (_vtable) {
+            _vtable->_destroy(_operation);
+        }
+    }
+
+    void start() & noexcept
+    {
+        auto token = execution::get_stop_token(_receiver);
+
+        if constexpr (std::is_same_v<stop_token_of_t<R>, inplace_stop_token>) {
+            _stop_token = std::move(token);
+        } else if (token.stop_possible()) {
+            _stop_callback.emplace(std::move(token), forward_stop_request{&_stop_source});
+            _stop_token = _stop_source.get_token();
+        }
+
+        try {
+            _vtable = _sender._vtable->_connect(
+                _sender._buffer,
+                _operation,
+                any_receiver_of<Sigs...>{*this});
+        } catch (...) {
+            set_error(std::current_exception());
+            return;
+        }
+
+        _vtable->_start(_operation);
+    }
+
+    template <typename ... Ts>
+    void set_value(Ts&& ... values)
+    {
+        _stop_callback.reset();
+        execution::set_value(std::move(_receiver), std::forward<Ts>(values)...);
+    }
+
+    void set_error(std::exception_ptr error)
+    {
+        _stop_callback.reset();
+        execution::set_error(std::move(_receiver), std::move(error));
+    }
+
+    void set_stopped()
+    {
+        _stop_callback.reset();
+        execution::set_stopped(std::move(_receiver));
+    }
+
+    // tag_invoke
+
+    friend auto tag_invoke(tag_t<get_stop_token>, const operation& self) noexcept
+        -> inplace_stop_token
+    {
+        return self._stop_token;
+    }
+};
+
+}   // namespace any_sender_impl
+
+////////////////////////////////////////////////////////////////////////////////
+
+// non-owning receiver with the completion signatures `Sigs...` (each one is
+// a `signature<Ts...>` of set_value) plus set_error(std::exception_ptr) and
+// set_stopped. Other errors are converted with as_exception_ptr. The
+// referenced receiver must outlive it and report either an
+// inplace_stop_token or no stop token at all
+template <typename ... Sigs>
+class any_receiver_of
+{
+    using vtable_t = any_sender_impl::receiver_vtable<Sigs...>;
+
+    void* _receiver;
+    vtable_t const* _vtable;
+
+public:
+    template <typename R>
+        requires (!std::is_same_v<std::remove_cvref_t<R>, any_receiver_of>)
+    explicit any_receiver_of(R& receiver) noexcept
+        : _receiver{&receiver}
+        , _vtable{&any_sender_impl::receiver_vtable_for<R, Sigs...>}
+    {
+        static_assert(
+            std::is_same_v<stop_token_of_t<R>, inplace_stop_token> ||
+            unstoppable_token<stop_token_of_t<R>>,
+            "any_receiver_of: the receiver's stop token can't be erased");
+    }
+
+    template <typename ... Ts>
+    void set_value(Ts&& ... values)
+    {
+        _vtable->set_value(_receiver, std::forward<Ts>(values)...);
+    }
+
+    template <typename E>
+    void set_error(E&& error)
+    {
+        _vtable->_set_error(
+            _receiver,
+            execution::as_exception_ptr(std::forward<E>(error)));
+    }
+
+    void set_stopped()
+    {
+        _vtable->_set_stopped(_receiver);
+    }
+
+    // tag_invoke
+
+    friend auto tag_invoke(tag_t<get_stop_token>, const any_receiver_of& self) noexcept
+        -> inplace_stop_token
+    {
+        return self._vtable->_get_stop_token(self._receiver);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+// owning, move-only sender that completes with the value signatures
+// `Sigs...`, std::exception_ptr or stopped. Small senders and their
+// operation states are kept inline; larger ones cost one heap allocation
+// each. Only the stop token is visible through the erased receiver, other
+// receiver queries get their defaults
+template <typename ... Sigs>
+class any_sender_of
+{
+    template <typename R, typename ... Ts>
+    friend class any_sender_impl::operation;
+
+    using vtable_t = any_sender_impl::sender_vtable<Sigs...>;
+
+    any_sender_impl::sender_buffer_t _buffer;
+    vtable_t const* _vtable;
+
+public:
+    template <typename R>
+    using operation_t = any_sender_impl::operation<std::decay_t<R>, Sigs...>;
+
+    using values_t = meta::list<Sigs...>;
+    using errors_t = meta::list<std::exception_ptr>;
+
+    template <typename S>
+        requires (!std::is_same_v<std::decay_t<S>, any_sender_of>)
+    any_sender_of(S&& sender)
+        : _vtable{&any_sender_impl::sender_vtable_for<std::decay_t<S>, Sigs...>}
+    {
+        _buffer.template emplace_with<std::decay_t<S>>([&] {
+            return std::decay_t<S>(std::forward<S>(sender));
+        });
+    }
+
+    any_sender_of(any_sender_of&& other) noexcept
+        : _vtable{std::exchange(other._vtable, nullptr)}
+    {
+        if (_vtable) {
+            _vtable->_move(other._buffer, _buffer);
+        }
+    }
+
+    any_sender_of& operator = (any_sender_of&& other) noexcept
+    {
+        if (this != &other) {
+            reset();
+            _vtable = std::exchange(other._vtable, nullptr);
+            if (_vtable) {
+                _vtable->_move(other._buffer, _buffer);
+            }
+        }
+        return *this;
+    }
+
+    ~any_sender_of()
+    {
+        reset();
+    }
+
+    template <typename R>
+    auto connect(R&& receiver) && -> operation_t<R>
+    {
+        return {std::move(*this), std::forward<R>(receiver)};
+    }
+
+private:
+    void reset() noexcept
+    {
+        if (_vtable) {
+            std::exchange(_vtable, nullptr)->_destroy(_buffer);
+        }
+    }
+};
+
+}   // namespace execution
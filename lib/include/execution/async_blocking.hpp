@@ -0,0 +1,224 @@
+#pragma once
+
+#include "blocking_pool.hpp"
+#include "customization.hpp"
+#include "get_scheduler.hpp"
+#include "schedule.hpp"
+#include "sender_traits.hpp"
+
+#include <exception>
+#include <functional>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace execution {
+namespace async_blocking_impl {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename R>
+concept has_scheduler = is_tag_invocable_v<tag_t<get_scheduler>, R const&>;
+
+template <typename F, typename R>
+struct operation;
+
+// `Back`: the schedule on the scheduler of the receiver, otherwise the one
+// on the blocking pool
+template <typename F, typename R, bool Back>
+struct receiver
+{
+    operation<F, R>* _op;
+
+    void set_value()
+    {
+        if constexpr (Back) {
+            _op->complete();
+        } else {
+            _op->run();
+        }
+    }
+
+    template <typename E>
+    void set_error(E&& error)
+    {
+        execution::set_error(std::move(_op->_receiver), std::forward<E>(error));
+    }
+
+    void set_stopped()
+    {
+        execution::set_stopped(std::move(_op->_receiver));
+    }
+
+    template <typename Tag, typename ... Ts>
+    friend auto tag_invoke(Tag tag, receiver const& self, Ts&& ... args)
+        noexcept(is_nothrow_tag_invocable_v<Tag, R, Ts...>)
+        -> tag_invoke_result_t<Tag, R, Ts...>
+    {
+        return std::invoke(tag, self._op->_receiver, std::forward<Ts>(args)...);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+using run_sender_t = decltype(blocking_pool().get_scheduler().schedule());
+
+// without a scheduler the receiver is completed on the blocking pool
+template <typename F, typename R>
+struct back_traits
+{
+    using operation_t = std::monostate;
+    using errors_t = meta::list<>;
+};
+
+template <typename F, typename R>
+    requires has_scheduler<R>
+struct back_traits<F, R>
+{
+    using scheduler_t = tag_invoke_result_t<tag_t<get_scheduler>, R const&>;
+    using sender_t = decltype(execution::schedule(std::declval<scheduler_t>()));
+    using receiver_t = receiver<F, R, true>;
+
+    using operation_t = typename sender_traits<sender_t, receiver_t>::operation_t;
+    using errors_t = decltype(traits::sender_errors(
+        meta::atom<sender_t>{},
+        meta::atom<receiver_t>{}));
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename F, typename R>
+struct operation
+{
+    using value_t = std::invoke_result_t<F>;
+    using result_t = std::conditional_t<
+        std::is_void_v<value_t>,
+        std::tuple<>,
+        std::tuple<value_t>>;
+
+    using run_receiver_t = receiver<F, R, false>;
+    using run_operation_t = typename sender_traits<run_sender_t, run_receiver_t>::operation_t;
+    using back_operation_t = typename back_traits<F, R>::operation_t;
+
+    F _func;
+    R _receiver;
+    std::optional<run_operation_t> _run = {};
+    std::optional<back_operation_t> _back = {};
+    std::optional<result_t> _value = {};
+    std::exception_ptr _error = {};
+
+    void start() &
+    {
+        auto& op = _run.emplace(execution::connect(
+            blocking_pool().get_scheduler().schedule(),
+            run_receiver_t{this}));
+
+        execution::start(op);
+    }
+
+    // on the blocking pool
+    void run()
+    {
+        try {
+            if constexpr (std::is_void_v<value_t>) {
+                std::invoke(std::move(_func));
+                _value.emplace();
+            } else {
+                _value.emplace(std::invoke(std::move(_func)));
+            }
+        } catch (...) {
+            _error = std::current_exception();
+        }
+
+        if constexpr (has_scheduler<R>) {
+            auto& op = _back.emplace(execution::connect(
+                execution::schedule(execution::get_scheduler(_receiver)),
+                receiver<F, R, true>{this}));
+
+            execution::start(op);
+        } else {
+            complete();
+        }
+    }
+
+    void complete()
+    {
+        if (_error) {
+            execution::set_error(std::move(_receiver), std::move(_error));
+        } else {
+            execution::apply_value(std::move(_receiver), std::move(*_value));
+        }
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename F>
+struct sender
+{
+    F _func;
+
+    template <typename R>
+    auto connect(R&& receiver) &
+    {
+        return operation<F, std::decay_t<R>>{_func, std::forward<R>(receiver)};
+    }
+
+    template <typename R>
+    auto connect(R&& receiver) &&
+    {
+        return operation<F, std::decay_t<R>>{std::move(_func), std::forward<R>(receiver)};
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename F, typename R>
+struct sender_traits
+{
+    using value_t = std::invoke_result_t<F>;
+
+    using operation_t = operation<F, R>;
+    using values_t = std::conditional_t<
+        std::is_void_v<value_t>,
+        meta::list<signature<>>,
+        meta::list<signature<value_t>>>;
+    using errors_t = decltype(meta::concat_unique(
+        traits::sender_errors(
+            meta::atom<run_sender_t>{},
+            meta::atom<receiver<F, R, false>>{}),
+        typename back_traits<F, R>::errors_t{},
+        meta::list<std::exception_ptr>{}));
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct async_blocking
+{
+    template <typename F>
+    constexpr auto operator () (F&& func) const
+    {
+        return sender<std::decay_t<F>>{std::forward<F>(func)};
+    }
+};
+
+}   // namespace async_blocking_impl
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename F, typename R>
+struct sender_traits<async_blocking_impl::sender<F>, R>
+    : async_blocking_impl::sender_traits<F, std::decay_t<R>>
+{};
+
+////////////////////////////////////////////////////////////////////////////////
+
+// calls `func` on the blocking_pool and completes with its result (or the
+// exception it throws) back on the scheduler of the receiver, see
+// get_scheduler. A receiver without a scheduler is completed on the
+// blocking pool
+constexpr auto async_blocking = async_blocking_impl::async_blocking{};
+
+}   // namespace execution
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "elastic_thread_pool.hpp"
+
+#include <cstddef>
+
+namespace execution {
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline constexpr std::size_t blocking_pool_max_workers = 512;
+
+// process wide pool for calls that block (file and console I/O, blocking
+// syscalls), so that they don't hold up the workers of a compute pool; see
+// async_blocking. It starts without workers, adds one whenever a task finds
+// none idle, up to blocking_pool_max_workers, and lets them retire after
+// 10s without work.
+//
+// Never destroyed: a worker blocked for good (e.g. on stdin) must not hang
+// the exit of the process
+elastic_thread_pool& blocking_pool();
+
+}   // namespace execution
@@ -0,0 +1,245 @@
+#pragma once
+
+#include "get_deadline.hpp"
+#include "metrics.hpp"
+#include "sender_traits.hpp"
+#include "spin_wait.hpp"
+#include "stop_token.hpp"
+#include "task_queue.hpp"
+#include "thread_options.hpp"
+#include "thread_pool_impl.hpp"
+#include "thread_pool_scheduler.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace execution {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// what a worker does with a task it dequeues after its deadline
+enum class late_policy
+{
+    run,    // runs it anyway; counted as late
+    shed,   // completes it with set_stopped
+};
+
+struct deadline_options
+{
+    late_policy policy = late_policy::run;
+};
+
+// a task that knows whether it was dequeued after its deadline
+struct deadline_task
+    : task_base
+{
+    bool _late = false;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+// earliest deadline first, FIFO among equal deadlines. Tasks without a
+// deadline come after all the others.
+//
+// Closed and sealed like task_queue
+class deadline_task_queue
+    : public task_queue_base
+{
+private:
+    struct entry
+    {
+        deadline_t _deadline;
+        std::uint64_t _seq;
+        task_base* _task;
+        bool* _late;
+
+        // the top of the heap is the earliest
+        bool operator < (entry const& other) const noexcept
+        {
+            return _deadline != other._deadline
+                ? _deadline > other._deadline
+                : _seq > other._seq;
+        }
+    };
+
+    std::vector<entry> _heap;
+    std::uint64_t _seq = 0;
+
+    std::atomic<std::uint64_t> _late = 0;
+
+public:
+    explicit deadline_task_queue(std::uint32_t spin_limit = adaptive_spin::default_limit) noexcept
+        : task_queue_base {spin_limit}
+    {}
+
+    // false once sealed
+    bool enqueue(task_base* task);
+    bool enqueue_n(task_base* task, std::size_t count);
+
+    // `*late` is set when the task is dequeued after its deadline
+    bool enqueue(deadline_t deadline, task_base* task, bool* late);
+    bool enqueue(deadline_t deadline, deadline_task* task);
+
+    // nullptr once the queue is closed and empty
+    task_base* dequeue();
+    task_base* try_dequeue();
+
+    // tasks dequeued after their deadline so far
+    std::uint64_t late_count() const noexcept
+    {
+        return _late.load(std::memory_order_relaxed);
+    }
+
+private:
+    bool push(deadline_t deadline, task_base* task, bool* late, std::size_t count);
+    task_base* pop();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace deadline_thread_pool_impl {
+
+// schedules the operation by the deadline of its receiver; the operation
+// of a late task completes with set_stopped when the pool sheds it
+template <typename T>
+struct schedule_by_deadline
+{
+    T* _pool;
+    deadline_t _deadline;
+
+    // set by the queue when the task is dequeued after its deadline
+    bool _late = false;
+
+    void operator () (task_base* task)
+    {
+        _pool->schedule(_deadline, task, &_late);
+    }
+
+    bool stop_requested() const noexcept
+    {
+        if (!_late || !_pool->shed_late()) {
+            return false;
+        }
+
+        _pool->count_shed();
+        return true;
+    }
+};
+
+template <typename T>
+struct sender
+{
+    T* _pool;
+
+    template <typename R>
+    auto connect(R&& receiver) const
+    {
+        auto const deadline = execution::get_deadline(receiver);
+
+        return thread_pool_scheduler_impl::operation {
+            schedule_by_deadline<T>{_pool, deadline},
+            std::forward<R>(receiver)
+        };
+    }
+};
+
+template <typename T>
+struct scheduler
+{
+    T* _pool;
+
+    auto schedule() const -> sender<T>
+    {
+        return {_pool};
+    }
+
+    bool operator == (scheduler const&) const noexcept = default;
+};
+
+}   // namespace deadline_thread_pool_impl
+
+template <typename T, typename R>
+struct sender_traits<deadline_thread_pool_impl::sender<T>, R>
+    : thread_pool_scheduler_impl::sender_traits_base<deadline_thread_pool_impl::sender<T>, R>
+{
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+// thread pool that runs the work with the earliest deadline first, see
+// get_deadline and with_deadline. Work that is dequeued after its deadline
+// is either run or shed with set_stopped, depending on the late_policy.
+//
+// stop() runs everything that is queued, then joins the workers; a task
+// scheduled after the workers have left runs on the calling thread
+class deadline_thread_pool
+    : thread_pool_impl<deadline_thread_pool>
+{
+    friend thread_pool_impl;
+
+public:
+    using scheduler_t = deadline_thread_pool_impl::scheduler<deadline_thread_pool>;
+
+private:
+    deadline_options _deadline_options;
+    deadline_task_queue _queue;
+    std::atomic<std::uint64_t> _shed = 0;
+    std::atomic_flag _should_stop = {};
+    std::atomic<std::size_t> _running;
+
+public:
+    explicit deadline_thread_pool(std::size_t worker_count);
+    deadline_thread_pool(thread_pool_options options, deadline_options const& deadlines);
+    ~deadline_thread_pool();
+
+    void stop();
+
+    // without a deadline
+    void schedule(task_base* task);
+    void schedule_n(task_base* task, std::size_t count);
+
+    void schedule(deadline_t deadline, task_base* task, bool* late);
+    void schedule(deadline_t deadline, deadline_task* task);
+
+    bool shed_late() const noexcept
+    {
+        return _deadline_options.policy == late_policy::shed;
+    }
+
+    void count_shed() noexcept
+    {
+        _shed.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // tasks dequeued after their deadline, and the part of them that was shed
+    std::uint64_t late_count() const noexcept
+    {
+        return _queue.late_count();
+    }
+
+    std::uint64_t shed_count() const noexcept
+    {
+        return _shed.load(std::memory_order_relaxed);
+    }
+
+    using thread_pool_impl::metrics;
+    using thread_pool_impl::options;
+
+    scheduler_t get_scheduler() noexcept
+    {
+        return {this};
+    }
+
+private:
+    deadline_task_queue& get_queue()
+    {
+        return _queue;
+    }
+
+    void exit_worker(std::size_t index);
+};
+
+}   // namespace execution
@@ -0,0 +1,167 @@
+#pragma once
+
+#include "spin_wait.hpp"
+#include "task_queue.hpp"
+#include "thread_options.hpp"
+#include "thread_pool_scheduler.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <list>
+#include <mutex>
+
+namespace execution {
+
+////////////////////////////////////////////////////////////////////////////////
+
+using elastic_clock_t = std::chrono::steady_clock;
+
+struct elastic_options
+{
+    // upper bound of the workers outside of a blocking_region;
+    // 0: std::thread::hardware_concurrency()
+    std::size_t max_workers = 0;
+
+    // a worker is added when a task waited this long in the queue and no
+    // worker is idle, at most one per period
+    elastic_clock_t::duration grow_after = std::chrono::milliseconds{1};
+
+    // a worker above the minimum retires after being idle this long
+    elastic_clock_t::duration idle_timeout = std::chrono::seconds{10};
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+// thread pool that keeps between thread_pool_options::worker_count and
+// elastic_options::max_workers threads. It grows while tasks keep waiting
+// in the queue and shrinks back when workers stay idle. A monitor thread,
+// started with thread_pool_options::dispatcher, looks at the oldest task
+// while no worker is idle, so that a backlog grows the pool even when
+// nothing else is scheduled. Worker indices aren't reused.
+//
+// A task that has to block marks it with a blocking_region, which adds a
+// compensating worker while no other one is idle; the blocked worker
+// doesn't count against max_workers.
+//
+// stop() runs everything that is queued, then joins the workers; once the
+// last of them has left, a task scheduled runs on the calling thread
+class elastic_thread_pool
+{
+public:
+    // on a worker of an elastic_thread_pool, tells the pool that the
+    // calling task is about to block; does nothing on any other thread
+    class blocking_region
+    {
+    private:
+        elastic_thread_pool* _pool;
+
+    public:
+        blocking_region();
+        ~blocking_region();
+
+        blocking_region(blocking_region const&) = delete;
+        blocking_region& operator = (blocking_region const&) = delete;
+    };
+
+private:
+    using threads_t = std::list<worker_thread>;
+
+    struct entry
+    {
+        task_base* _task;
+        elastic_clock_t::time_point _enqueued_at;
+    };
+
+    thread_pool_options _options;
+    elastic_options _elastic;
+
+    std::mutex _mtx;
+    std::condition_variable _cv;
+    std::deque<entry> _tasks;
+
+    worker_thread _monitor;
+    std::condition_variable _monitor_cv;
+
+    // the size of _tasks, polled without the lock by spinning workers
+    std::atomic<std::size_t> _size = 0;
+
+    adaptive_spin _spin;
+
+    // guarded by _mtx
+    threads_t _threads;
+    threads_t _retired;
+    std::size_t _workers = 0;
+    std::size_t _idle = 0;
+    std::size_t _blocked = 0;
+    std::size_t _next_index = 0;
+    elastic_clock_t::time_point _last_growth;
+    bool _monitor_parked = false;
+    bool _stopping = false;
+
+    // the tasks are refused, the workers are gone
+    bool _sealed = false;
+
+public:
+    elastic_thread_pool(std::size_t min_workers, std::size_t max_workers);
+
+    // throws std::system_error if the monitor or the minimum of workers
+    // can't be started;
+    // a worker added later that fails to start is skipped
+    elastic_thread_pool(thread_pool_options options, elastic_options const& elastic);
+    ~elastic_thread_pool();
+
+    elastic_thread_pool(elastic_thread_pool const&) = delete;
+    elastic_thread_pool& operator = (elastic_thread_pool const&) = delete;
+
+    // runs what is queued, including what the tasks schedule meanwhile,
+    // then joins the workers
+    void stop();
+
+    void schedule(task_base* task);
+    void schedule_n(task_base* task, std::size_t count);
+
+    // the workers that are running, including the blocked ones
+    std::size_t size();
+
+    // the workers in a blocking_region
+    std::size_t blocked();
+
+    std::size_t min_workers() const noexcept
+    {
+        return _options.worker_count;
+    }
+
+    std::size_t max_workers() const noexcept
+    {
+        return _elastic.max_workers;
+    }
+
+    thread_pool_options const& options() const noexcept
+    {
+        return _options;
+    }
+
+    thread_pool_scheduler<elastic_thread_pool> get_scheduler()
+    {
+        return {this};
+    }
+
+private:
+    void worker(threads_t::iterator self, std::size_t index);
+    bool wait_for_task(std::unique_lock<std::mutex>& lock, threads_t::iterator self);
+    void retire(std::unique_lock<std::mutex>& lock, threads_t::iterator self);
+
+    void monitor();
+    void wake_monitor();
+
+    void add_worker();
+    bool grow(elastic_clock_t::time_point enqueued_at);
+
+    void begin_blocking();
+    void end_blocking();
+};
+
+}   // namespace execution
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "get_allocator.hpp"
 #include "null_receiver.hpp"
 #include "pipeable.hpp"
 #include "sender_traits.hpp"
@@ -17,11 +18,13 @@ namespace ensure_started_impl {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename T>
+template <typename T, typename A>
 struct shared_state
 {
+    [[ no_unique_address ]] A _allocator;
+
     T _storage;
-    std::stop_source _stop_source;
+    inplace_stop_source _stop_source;
     std::atomic_flag _flag = {};
 
     void* _obj = nullptr;
@@ -82,9 +85,15 @@ struct receiver
     // tag_invoke
 
     friend auto tag_invoke(tag_t<get_stop_token>, const receiver<T>& self) noexcept
+        -> inplace_stop_token
     {
         return self._state->_stop_source.get_token();
     }
+
+    friend auto tag_invoke(tag_t<get_allocator>, const receiver<T>& self) noexcept
+    {
+        return self._state->_allocator;
+    }
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -102,9 +111,13 @@ struct operation
         }
     };
 
+    using stop_callback_t = stop_callback_for_t<
+        stop_token_of_t<R>,
+        cancel_callback>;
+
     R _receiver;
     std::shared_ptr<T> _state;
-    std::optional<std::stop_callback<cancel_callback>> _stop_callback;
+    std::optional<stop_callback_t> _stop_callback;
 
     template <typename U>
     operation(U&& receiver, std::shared_ptr<T>&& state)
@@ -121,9 +134,10 @@ struct operation
 
     void start() & noexcept
     {
-        _stop_callback.emplace(
-            execution::get_stop_token(_receiver),
-            cancel_callback{this});
+        auto token = execution::get_stop_token(_receiver);
+        if (token.stop_possible()) {
+            _stop_callback.emplace(std::move(token), cancel_callback{this});
+        }
 
         _state->_obj = this;
         _state->_finish = [] (void* obj) {
@@ -215,6 +229,14 @@ struct ensure_started
 
     template <typename S>
     constexpr auto operator () (S&& source) const
+    {
+        return (*this)(std::forward<S>(source), std::allocator<std::byte>{});
+    }
+
+    // the shared state and the operation are allocated with `allocator`,
+    // which is also handed to the algorithms of `source`
+    template <typename S, typename A>
+    constexpr auto operator () (S&& source, A const& allocator) const
     {
         using source_t = std::decay_t<S>;
 
@@ -246,13 +268,17 @@ struct ensure_started
             | error_types
         )>;
 
-        using state_t = shared_state<storage_t>;
+        using state_t = shared_state<storage_t, A>;
 
         using operation_t = typename sender_traits<source_t, receiver<state_t>>
             ::operation_t;
 
-        auto state = std::make_shared<state_t>();
-        auto op = std::make_shared<operation_t>(
+        auto state = std::allocate_shared<state_t>(
+            rebind_allocator_t<A, state_t>{allocator},
+            allocator);
+
+        auto op = std::allocate_shared<operation_t>(
+            rebind_allocator_t<A, operation_t>{allocator},
             execution::connect(std::forward<S>(source), receiver<state_t>{state}));
 
         state->_operation = op;
@@ -0,0 +1,291 @@
+#pragma once
+
+#include "task_queue.hpp"
+#include "thread_pool_scheduler.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace execution {
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fair_queue_impl {
+
+template <typename Q>
+struct schedule_on
+{
+    Q* _queue;
+    typename Q::tenant* _tenant;
+
+    void operator () (task_base* task) const
+    {
+        _queue->schedule(_tenant, task);
+    }
+
+    // see thread_pool_scheduler_impl::schedule_on
+    bool stop_requested() const noexcept
+        requires requires (Q const& queue) { queue.stop_requested(); }
+    {
+        return _queue->stop_requested();
+    }
+};
+
+template <typename Q>
+struct sender
+{
+    Q* _queue;
+    typename Q::tenant* _tenant;
+
+    template <typename R>
+    auto connect(R&& receiver) const
+    {
+        return thread_pool_scheduler_impl::operation {
+            schedule_on<Q>{_queue, _tenant},
+            std::forward<R>(receiver)
+        };
+    }
+};
+
+template <typename Q>
+struct scheduler
+{
+    Q* _queue;
+    typename Q::tenant* _tenant;
+
+    auto schedule() const -> sender<Q>
+    {
+        return {_queue, _tenant};
+    }
+
+    bool operator == (scheduler const&) const noexcept = default;
+};
+
+}   // namespace fair_queue_impl
+
+template <typename Q, typename R>
+struct sender_traits<fair_queue_impl::sender<Q>, R>
+    : thread_pool_scheduler_impl::sender_traits_base<fair_queue_impl::sender<Q>, R>
+{
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+// shares a pool between tenants in proportion to their weights. Each tenant
+// has its own FIFO, and the pool only ever sees up to `concurrency`
+// dispatch tasks, which take the next task by deficit round robin: a
+// tenant with weight w runs up to w tasks in a row before the next one
+// gets its turn. A tenant that floods its queue only delays itself.
+// Destroying the queue waits for the tasks it handed to the pool, so it
+// must not be destroyed from inside one of them
+template <typename P>
+class fair_queue
+{
+public:
+    using tenant_id = std::uint64_t;
+
+    struct tenant
+    {
+        std::queue<task_base*> _tasks;
+        std::uint32_t _weight = 1;
+        std::uint32_t _deficit = 0;
+        bool _active = false;
+    };
+
+    using scheduler_t = fair_queue_impl::scheduler<fair_queue>;
+
+private:
+    struct dispatch_task
+        : task_base
+    {
+        fair_queue* _queue = nullptr;
+
+        dispatch_task()
+            : task_base {
+                ._execute = static_cast<task_base::execute_t>(&dispatch_task::execute)
+            }
+        {}
+
+        void execute()
+        {
+            _queue->dispatch(this);
+        }
+    };
+
+    P* _pool;
+
+    std::mutex _mtx;
+    std::unordered_map<tenant_id, tenant> _tenants;
+
+    // tenants with queued tasks, in round robin order
+    std::deque<tenant*> _active;
+
+    std::size_t _concurrency;
+    std::unique_ptr<dispatch_task[]> _dispatchers;
+    std::vector<dispatch_task*> _idle;
+
+    // signaled when a dispatcher becomes idle
+    std::condition_variable _cv;
+
+public:
+    fair_queue(P& pool, std::size_t concurrency)
+        : _pool {&pool}
+        , _concurrency {concurrency}
+        , _dispatchers {std::make_unique<dispatch_task[]>(concurrency)}
+    {
+        _idle.reserve(concurrency);
+        for (std::size_t i = 0; i != concurrency; ++i) {
+            _dispatchers[i]._queue = this;
+            _idle.push_back(&_dispatchers[i]);
+        }
+    }
+
+    fair_queue(fair_queue const&) = delete;
+    fair_queue& operator = (fair_queue const&) = delete;
+
+    // a task may complete a receiver that lets another thread destroy the
+    // queue while the dispatcher of the task still runs. A task that
+    // destroyed the queue itself would wait here for its own dispatcher
+    ~fair_queue()
+    {
+        std::unique_lock lock {_mtx};
+
+        _cv.wait(lock, [this] {
+            return _idle.size() == _concurrency;
+        });
+    }
+
+    // the operations of a pool that was asked to stop complete with
+    // set_stopped, see thread_pool::request_stop
+    bool stop_requested() const noexcept
+        requires requires (P const& pool) { pool.stop_requested(); }
+    {
+        return _pool->stop_requested();
+    }
+
+    // the tenant is created with weight 1 on first use
+    scheduler_t get_scheduler(tenant_id id)
+    {
+        std::unique_lock lock {_mtx};
+
+        return {this, &_tenants[id]};
+    }
+
+    void set_weight(tenant_id id, std::uint32_t weight)
+    {
+        std::unique_lock lock {_mtx};
+
+        _tenants[id]._weight = std::max<std::uint32_t>(weight, 1);
+    }
+
+    // tasks of the tenant waiting for a dispatcher
+    std::size_t size(tenant_id id)
+    {
+        std::unique_lock lock {_mtx};
+
+        auto it = _tenants.find(id);
+        return it == _tenants.end() ? 0 : it->second._tasks.size();
+    }
+
+    void schedule(tenant* t, task_base* task)
+    {
+        std::unique_lock lock {_mtx};
+
+        t->_tasks.push(task);
+
+        if (!t->_active) {
+            t->_active = true;
+            t->_deficit = t->_weight;
+            _active.push_back(t);
+        }
+
+        if (_idle.empty()) {
+            return;
+        }
+
+        auto* dispatcher = _idle.back();
+        _idle.pop_back();
+
+        lock.unlock();
+
+        _pool->schedule(dispatcher);
+    }
+
+private:
+    // runs one task, then queues the dispatcher again behind the other
+    // work of the pool if there is more to do
+    void dispatch(dispatch_task* self)
+    {
+        std::unique_lock lock {_mtx};
+
+        // another dispatcher took the tasks this one was queued for
+        if (_active.empty()) {
+            make_idle(self);
+            return;
+        }
+
+        auto* task = next();
+
+        lock.unlock();
+
+        std::invoke(task->_execute, task);
+
+        lock.lock();
+
+        if (_active.empty()) {
+            make_idle(self);
+            return;
+        }
+
+        lock.unlock();
+
+        _pool->schedule(self);
+    }
+
+    // called with the lock held, which the destructor waits for
+    void make_idle(dispatch_task* self)
+    {
+        _idle.push_back(self);
+        _cv.notify_all();
+    }
+
+    // called with the lock held and an active tenant
+    task_base* next()
+    {
+        for (;;) {
+            auto* t = _active.front();
+
+            if (t->_deficit) {
+                --t->_deficit;
+
+                auto* task = t->_tasks.front();
+                t->_tasks.pop();
+
+                // an idle tenant doesn't keep its credit
+                if (t->_tasks.empty()) {
+                    t->_active = false;
+                    t->_deficit = 0;
+                    _active.pop_front();
+                }
+
+                return task;
+            }
+
+            _active.pop_front();
+            t->_deficit = t->_weight;
+            _active.push_back(t);
+        }
+    }
+};
+
+}   // namespace execution
@@ -3,6 +3,7 @@
 #include "pipeable.hpp"
 #include "sender_traits.hpp"
 #include "stop_token.hpp"
+#include "trace.hpp"
 #include "tuple.hpp"
 #include "variant.hpp"
 
@@ -167,6 +168,8 @@ struct operation
 
     void start_completion(C&& completion)
     {
+        execution::get_tracer(_receiver).async_begin("finally", this);
+
         auto& op = _state.template emplace<2>(
             execution::connect(std::move(completion), completion_receiver_t{this})
         );
@@ -228,16 +231,20 @@ struct operation
     template <typename E>
     void completion_error(E&& error)
     {
+        execution::get_tracer(_receiver).async_end("finally", this);
         execution::set_error(std::move(_receiver), std::forward<E>(error));
     }
 
     void completion_stopped()
     {
+        execution::get_tracer(_receiver).async_end("finally", this);
         execution::set_stopped(std::move(_receiver));
     }
 
     void finish() noexcept
     {
+        execution::get_tracer(_receiver).async_end("finally", this);
+
         try {
             std::visit([this] (auto&& tuple) {
                 std::apply(
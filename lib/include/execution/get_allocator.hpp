@@ -0,0 +1,45 @@
+#pragma once
+
+#include "customization.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace execution {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// query a receiver for the allocator that algorithms should use for the
+// memory they need on its behalf (shared states, detached operations, etc)
+inline constexpr struct get_allocator_fn
+{
+    // default implementation
+    template <typename R>
+        requires (!is_tag_invocable_v<get_allocator_fn, R const&>)
+    auto operator () (R const&) const noexcept
+    {
+        return std::allocator<std::byte>{};
+    }
+
+    template <typename R>
+        requires is_tag_invocable_v<get_allocator_fn, R const&>
+    auto operator () (R const& obj) const noexcept
+        -> tag_invoke_result_t<get_allocator_fn, R const&>
+    {
+        return execution::tag_invoke(*this, obj);
+    }
+
+} get_allocator;
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename R>
+using allocator_of_t = std::remove_cvref_t<
+    decltype(execution::get_allocator(std::declval<R const&>()))>;
+
+template <typename A, typename T>
+using rebind_allocator_t =
+    typename std::allocator_traits<A>::template rebind_alloc<T>;
+
+}   // namespace execution
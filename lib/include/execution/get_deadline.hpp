@@ -0,0 +1,38 @@
+#pragma once
+
+#include "customization.hpp"
+
+#include <chrono>
+#include <type_traits>
+
+namespace execution {
+
+////////////////////////////////////////////////////////////////////////////////
+
+using deadline_clock_t = std::chrono::steady_clock;
+using deadline_t = deadline_clock_t::time_point;
+
+inline constexpr deadline_t no_deadline = deadline_t::max();
+
+// query a receiver for the time by which the work it waits for should be
+// done; schedulers that order work by urgency use it
+inline constexpr struct get_deadline_fn
+{
+    // default implementation
+    template <typename R>
+        requires (!is_tag_invocable_v<get_deadline_fn, R const&>)
+    constexpr deadline_t operator () (R const&) const noexcept
+    {
+        return no_deadline;
+    }
+
+    template <typename R>
+        requires is_tag_invocable_v<get_deadline_fn, R const&>
+    deadline_t operator () (R const& obj) const noexcept
+    {
+        return execution::tag_invoke(*this, obj);
+    }
+
+} get_deadline;
+
+}   // namespace execution
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "customization.hpp"
+
+#include <utility>
+
+namespace execution {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// query a receiver for the scheduler of the context it's going to be
+// completed on (e.g. the run loop driven by sync_wait)
+inline constexpr struct get_scheduler_fn
+{
+    template <typename R>
+        requires is_tag_invocable_v<get_scheduler_fn, R const&>
+    auto operator () (R const& obj) const noexcept
+        -> tag_invoke_result_t<get_scheduler_fn, R const&>
+    {
+        return execution::tag_invoke(*this, obj);
+    }
+
+} get_scheduler;
+
+}   // namespace execution
@@ -0,0 +1,334 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace execution {
+
+class inplace_stop_source;
+class inplace_stop_token;
+
+template <typename F>
+class inplace_stop_callback;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class inplace_stop_callback_base
+{
+    friend inplace_stop_source;
+
+protected:
+    using execute_t = void (*)(inplace_stop_callback_base*) noexcept;
+
+    inplace_stop_source const* _source;
+    execute_t _execute;
+
+    inplace_stop_callback_base* _next = nullptr;
+    inplace_stop_callback_base** _prev = nullptr;
+    bool* _removed_during_callback = nullptr;
+    std::atomic<bool> _callback_completed = false;
+
+    inplace_stop_callback_base(
+            inplace_stop_source const* source,
+            execute_t execute) noexcept
+        : _source{source}
+        , _execute{execute}
+    {}
+
+    void register_callback() noexcept;
+    void unregister_callback() noexcept;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+// stop source that lives inside of an operation state: no shared state is
+// allocated, callbacks are kept in an intrusive list guarded by a spin bit
+// in the same word as the stop flag
+class inplace_stop_source
+{
+    friend inplace_stop_callback_base;
+
+private:
+    static constexpr std::uint8_t stop_requested_flag = 1;
+    static constexpr std::uint8_t locked_flag = 2;
+
+    mutable std::atomic<std::uint8_t> _state = 0;
+    mutable inplace_stop_callback_base* _callbacks = nullptr;
+    std::thread::id _notifying_thread;
+
+public:
+    inplace_stop_source() noexcept = default;
+
+    inplace_stop_source(inplace_stop_source const&) = delete;
+    inplace_stop_source(inplace_stop_source&&) = delete;
+
+    inplace_stop_source& operator = (inplace_stop_source const&) = delete;
+    inplace_stop_source& operator = (inplace_stop_source&&) = delete;
+
+    ~inplace_stop_source()
+    {
+        assert((_state.load(std::memory_order_relaxed) & locked_flag) == 0);
+        assert(_callbacks == nullptr);
+    }
+
+    inplace_stop_token get_token() const noexcept;
+
+    bool stop_requested() const noexcept
+    {
+        return _state.load(std::memory_order_acquire) & stop_requested_flag;
+    }
+
+    static constexpr bool stop_possible() noexcept
+    {
+        return true;
+    }
+
+    bool request_stop() noexcept
+    {
+        if (!try_lock_unless_stop_requested(true)) {
+            return false;
+        }
+
+        _notifying_thread = std::this_thread::get_id();
+
+        while (_callbacks) {
+            auto* cb = _callbacks;
+            cb->_prev = nullptr;
+            _callbacks = cb->_next;
+            if (_callbacks) {
+                _callbacks->_prev = &_callbacks;
+            }
+
+            unlock(stop_requested_flag);
+
+            bool removed_during_callback = false;
+            cb->_removed_during_callback = &removed_during_callback;
+
+            cb->_execute(cb);
+
+            if (!removed_during_callback) {
+                cb->_removed_during_callback = nullptr;
+                cb->_callback_completed.store(true, std::memory_order_release);
+            }
+
+            lock();
+        }
+
+        unlock(stop_requested_flag);
+
+        return true;
+    }
+
+private:
+    std::uint8_t lock() const noexcept
+    {
+        auto old = _state.load(std::memory_order_relaxed);
+
+        do {
+            while (old & locked_flag) {
+                std::this_thread::yield();
+                old = _state.load(std::memory_order_relaxed);
+            }
+        } while (!_state.compare_exchange_weak(
+            old,
+            old | locked_flag,
+            std::memory_order_acquire,
+            std::memory_order_relaxed));
+
+        return old;
+    }
+
+    void unlock(std::uint8_t old) const noexcept
+    {
+        _state.store(old, std::memory_order_release);
+    }
+
+    bool try_lock_unless_stop_requested(bool set_stop_requested) const noexcept
+    {
+        auto old = _state.load(std::memory_order_relaxed);
+
+        do {
+            for (;;) {
+                if (old & stop_requested_flag) {
+                    return false;
+                }
+
+                if (old == 0) {
+                    break;
+                }
+
+                std::this_thread::yield();
+                old = _state.load(std::memory_order_relaxed);
+            }
+        } while (!_state.compare_exchange_weak(
+            old,
+            set_stop_requested
+                ? (locked_flag | stop_requested_flag)
+                : locked_flag,
+            std::memory_order_acq_rel,
+            std::memory_order_relaxed));
+
+        return true;
+    }
+
+    bool try_add_callback(inplace_stop_callback_base* cb) const noexcept
+    {
+        if (!try_lock_unless_stop_requested(false)) {
+            return false;
+        }
+
+        cb->_next = _callbacks;
+        cb->_prev = &_callbacks;
+        if (_callbacks) {
+            _callbacks->_prev = &cb->_next;
+        }
+        _callbacks = cb;
+
+        unlock(0);
+
+        return true;
+    }
+
+    void remove_callback(inplace_stop_callback_base* cb) const noexcept
+    {
+        auto const old = lock();
+
+        if (cb->_prev) {
+            // callback has not been executed yet
+            *cb->_prev = cb->_next;
+            if (cb->_next) {
+                cb->_next->_prev = cb->_prev;
+            }
+            unlock(old);
+            return;
+        }
+
+        auto const notifying_thread = _notifying_thread;
+        unlock(old);
+
+        if (std::this_thread::get_id() == notifying_thread) {
+            // removed from inside of the callback itself
+            if (cb->_removed_during_callback) {
+                *cb->_removed_during_callback = true;
+            }
+            return;
+        }
+
+        while (!cb->_callback_completed.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+class inplace_stop_token
+{
+    friend inplace_stop_source;
+
+    template <typename F>
+    friend class inplace_stop_callback;
+
+private:
+    inplace_stop_source const* _source = nullptr;
+
+    explicit inplace_stop_token(inplace_stop_source const* source) noexcept
+        : _source{source}
+    {}
+
+public:
+    template <typename F>
+    using callback_type = inplace_stop_callback<F>;
+
+    inplace_stop_token() noexcept = default;
+
+    bool stop_requested() const noexcept
+    {
+        return _source && _source->stop_requested();
+    }
+
+    bool stop_possible() const noexcept
+    {
+        return _source != nullptr;
+    }
+
+    void swap(inplace_stop_token& other) noexcept
+    {
+        std::swap(_source, other._source);
+    }
+
+    bool operator == (inplace_stop_token const&) const noexcept = default;
+};
+
+inline inplace_stop_token inplace_stop_source::get_token() const noexcept
+{
+    return inplace_stop_token{this};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename F>
+class inplace_stop_callback
+    : inplace_stop_callback_base
+{
+private:
+    F _func;
+
+public:
+    template <typename U>
+    explicit inplace_stop_callback(inplace_stop_token token, U&& func)
+            noexcept(std::is_nothrow_constructible_v<F, U>)
+        : inplace_stop_callback_base{token._source, &execute}
+        , _func(std::forward<U>(func))
+    {
+        register_callback();
+    }
+
+    inplace_stop_callback(inplace_stop_callback const&) = delete;
+    inplace_stop_callback(inplace_stop_callback&&) = delete;
+
+    inplace_stop_callback& operator = (inplace_stop_callback const&) = delete;
+    inplace_stop_callback& operator = (inplace_stop_callback&&) = delete;
+
+    ~inplace_stop_callback()
+    {
+        unregister_callback();
+    }
+
+private:
+    static void execute(inplace_stop_callback_base* cb) noexcept
+    {
+        std::move(static_cast<inplace_stop_callback*>(cb)->_func)();
+    }
+};
+
+template <typename F>
+inplace_stop_callback(inplace_stop_token, F) -> inplace_stop_callback<F>;
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline void inplace_stop_callback_base::register_callback() noexcept
+{
+    if (!_source) {
+        return;
+    }
+
+    if (!_source->try_add_callback(this)) {
+        // stop has already been requested
+        _source = nullptr;
+        _execute(this);
+    }
+}
+
+inline void inplace_stop_callback_base::unregister_callback() noexcept
+{
+    if (_source) {
+        _source->remove_callback(this);
+    }
+}
+
+}   // namespace execution
@@ -3,6 +3,7 @@
 #include "customization.hpp"
 #include "pipeable.hpp"
 #include "sender_traits.hpp"
+#include "trace.hpp"
 #include "tuple.hpp"
 #include "variant.hpp"
 
@@ -139,8 +140,13 @@ struct operation
         using successor_t = std::decay_t<decltype(std::apply(std::move(_factory), tuple))>;
         using operation_t = typename execution::sender_traits<successor_t, R>::operation_t;
 
+        auto factory = execution::trace_call(
+            execution::get_tracer(_receiver),
+            "let_value",
+            std::move(_factory));
+
         auto& op = _state.template emplace<operation_t>(execution::connect(
-            std::apply(std::move(_factory), tuple),
+            std::apply(std::move(factory), tuple),
             std::move(_receiver)
         ));
 
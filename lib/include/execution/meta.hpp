@@ -23,6 +23,52 @@ using index_t = atom<int_constant_t<value>>;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+// index lookup without recursion: the compiler builtin where available,
+// otherwise overload resolution against a flat set of indexed bases
+
+namespace meta_impl {
+
+template <int I, typename T>
+struct indexed
+{
+    using type = T;
+};
+
+template <typename Is, typename ... Ts>
+struct indexer;
+
+template <int ... Is, typename ... Ts>
+struct indexer<std::integer_sequence<int, Is...>, Ts...> : indexed<Is, Ts>...
+{};
+
+template <int I, typename T>
+auto select(indexed<I, T> const&) -> indexed<I, T>;
+
+#if defined(__has_builtin)
+#if __has_builtin(__type_pack_element)
+#define EXECUTION_META_TYPE_PACK_ELEMENT
+#endif
+#endif
+
+#if defined(EXECUTION_META_TYPE_PACK_ELEMENT)
+
+template <int I, typename ... Ts>
+using type_at_t = __type_pack_element<I, Ts...>;
+
+#else
+
+template <int I, typename ... Ts>
+using type_at_t = typename decltype(select<I>(
+    indexer<std::make_integer_sequence<int, sizeof ... (Ts)>, Ts...>{}))::type;
+
+#endif
+
+#undef EXECUTION_META_TYPE_PACK_ELEMENT
+
+}   // namespace meta_impl
+
+////////////////////////////////////////////////////////////////////////////////
+
 template <typename ... Ts>
 struct list;
 
@@ -38,7 +84,10 @@ struct list<H, Ts...>
     static constexpr int size = 1 + sizeof ... (Ts);
 
     static constexpr auto head = atom<H>{};
-    static constexpr auto tail = list<Ts...>{};
+
+    // defined out of class so that naming a list doesn't instantiate all of
+    // its suffixes
+    static const list<Ts...> tail;
 
     template <int index>
     constexpr auto operator [] (index_t<index>) const
@@ -49,18 +98,15 @@ struct list<H, Ts...>
             "index overflow"
         );
 
-        if constexpr (index == 0 || -index == list::size) {
-            return list::head;
-        } else {
-            if constexpr (index < 0) {
-                return list::tail[index_t<list::size + index - 1>{}];
-            } else {
-                return list::tail[index_t<index - 1>{}];
-            }
-        }
+        constexpr int i = index < 0 ? list::size + index : index;
+
+        return atom<meta_impl::type_at_t<i, H, Ts...>>{};
     }
 };
 
+template <typename H, typename ... Ts>
+constexpr list<Ts...> list<H, Ts...>::tail {};
+
 ////////////////////////////////////////////////////////////////////////////////
 
 template <typename T, typename H>
@@ -107,56 +153,80 @@ constexpr auto operator | (list<Ts...>, atom<T>)
 ////////////////////////////////////////////////////////////////////////////////
 
 template <typename ... Ts, typename T>
-constexpr auto find(list<Ts...> ls, T value)
+constexpr auto find(list<Ts...>, atom<T>)
 {
-    if constexpr (ls.size == 0) {
-        return -1;
-    } else {
-        if constexpr (ls.head == value) {
-            return 0;
-        } else {
-            const int i = find(ls.tail, value);
-            if (i == -1) {
-                return -1;
-            }
-            return 1 + i;
+    constexpr bool matches[] = {std::is_same_v<Ts, T>..., false};
+
+    for (int i = 0; i != sizeof ... (Ts); ++i) {
+        if (matches[i]) {
+            return i;
         }
     }
+
+    return -1;
 }
 
 template <typename ... Ts, typename T>
-constexpr auto contains(list<Ts...> ls, T item)
+constexpr auto contains(list<Ts...>, atom<T>)
 {
-    return find(ls, item) != -1;
+    return (std::is_same_v<Ts, T> || ...);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
+// keeps the last occurrence of each type; membership is a single base class
+// lookup in the set built so far
+
+namespace meta_impl {
 
 template <typename ... Ts>
-constexpr auto unique(list<Ts...> ls)
+struct set : atom<Ts>...
+{};
+
+template <typename T, typename ... Ts>
+constexpr auto operator + (atom<T>, set<Ts...> s)
 {
-    if constexpr (ls.size == 0) {
-        return ls;
+    if constexpr (std::is_base_of_v<atom<T>, set<Ts...>>) {
+        return s;
     } else {
-        auto tail = unique(ls.tail);
-
-        if constexpr (contains(ls.tail, ls.head)) {
-            return tail;
-        } else {
-            return ls.head | tail;
-        }
+        return set<T, Ts...>{};
     }
 }
 
+template <typename ... Ts>
+constexpr auto to_list(set<Ts...>) -> list<Ts...>
+{
+    return {};
+}
+
+}   // namespace meta_impl
+
+template <typename ... Ts>
+constexpr auto unique(list<Ts...>)
+{
+    return meta_impl::to_list((atom<Ts>{} + ... + meta_impl::set<>{}));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
+namespace meta_impl {
+
+template <typename T>
+constexpr bool is_atom_v = false;
+
+template <typename T>
+constexpr bool is_atom_v<atom<T>> = true;
+
+}   // namespace meta_impl
+
+// func returns either an atom or a list to be spliced into the result; the
+// common all-atoms case is a single pack expansion
 template <typename ... Ts, typename F>
-constexpr auto transform(list<Ts...> ls, F func)
+constexpr auto transform(list<Ts...>, F func)
 {
-    if constexpr (ls.size == 0) {
-        return ls;
+    if constexpr ((meta_impl::is_atom_v<decltype(func(atom<Ts>{}))> && ...)) {
+        return list<typename decltype(func(atom<Ts>{}))::type...>{};
     } else {
-        return func(ls.head) | transform(ls.tail, func);
+        return (list<>{} | ... | func(atom<Ts>{}));
     }
 }
 
@@ -236,15 +306,15 @@ constexpr auto is_all = [] <typename ... Ts>  (list<Ts...>, auto func) constexpr
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename L1, typename L2, typename F>
-constexpr auto zip_transform(L1 l1, L2 l2, F fn)
+template <typename ... Ts, typename ... Hs, typename F>
+constexpr auto zip_transform(list<Ts...>, list<Hs...>, F fn)
 {
-    static_assert(l1.size == l2.size);
+    static_assert(sizeof ... (Ts) == sizeof ... (Hs));
 
-    if constexpr (l1.size == 0) {
-        return l1;
+    if constexpr ((meta_impl::is_atom_v<decltype(fn(atom<Ts>{}, atom<Hs>{}))> && ...)) {
+        return list<typename decltype(fn(atom<Ts>{}, atom<Hs>{}))::type...>{};
     } else {
-        return fn(l1.head, l2.head) | zip_transform(l1.tail, l2.tail, fn);
+        return (list<>{} | ... | fn(atom<Ts>{}, atom<Hs>{}));
     }
 }
 
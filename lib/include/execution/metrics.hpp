@@ -0,0 +1,220 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace execution {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// scheduler instrumentation is compiled in only when EXECUTION_ENABLE_METRICS
+// is defined (see the EXECUTION_METRICS cmake option), otherwise the hooks
+// below are empty and get optimized away
+
+#if defined(EXECUTION_ENABLE_METRICS)
+inline constexpr bool metrics_enabled = true;
+#else
+inline constexpr bool metrics_enabled = false;
+#endif
+
+using metrics_clock_t = std::chrono::steady_clock;
+
+////////////////////////////////////////////////////////////////////////////////
+
+// enqueue timestamp carried by every task: an empty type when disabled
+struct task_timestamp_enabled
+{
+    metrics_clock_t::time_point _value;
+
+    void set(metrics_clock_t::time_point tp) noexcept
+    {
+        _value = tp;
+    }
+
+    metrics_clock_t::time_point get() const noexcept
+    {
+        return _value;
+    }
+};
+
+struct task_timestamp_disabled
+{
+    void set(metrics_clock_t::time_point) noexcept
+    {}
+
+    metrics_clock_t::time_point get() const noexcept
+    {
+        return {};
+    }
+};
+
+using task_timestamp = std::conditional_t<
+    metrics_enabled,
+    task_timestamp_enabled,
+    task_timestamp_disabled>;
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct histogram_snapshot
+{
+    // bucket i counts samples in [2^i, 2^(i+1)) ns, bucket 0 also takes 0
+    static constexpr std::size_t bucket_count = 40;
+
+    std::array<std::uint64_t, bucket_count> buckets = {};
+    std::uint64_t count = 0;
+    std::uint64_t sum = 0;
+
+    std::chrono::nanoseconds mean() const noexcept
+    {
+        return std::chrono::nanoseconds{count ? sum / count : 0};
+    }
+
+    // upper bound of the bucket that contains the p-th quantile, p in [0, 1]
+    std::chrono::nanoseconds percentile(double p) const noexcept
+    {
+        if (!count) {
+            return {};
+        }
+
+        auto const rank = std::min(
+            static_cast<std::uint64_t>(p * count),
+            count - 1);
+
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i != bucket_count; ++i) {
+            seen += buckets[i];
+            if (seen > rank) {
+                return std::chrono::nanoseconds{std::int64_t{2} << i};
+            }
+        }
+
+        return std::chrono::nanoseconds{std::int64_t{2} << (bucket_count - 1)};
+    }
+};
+
+class histogram
+{
+private:
+    using buckets_t = std::array<
+        std::atomic<std::uint64_t>,
+        histogram_snapshot::bucket_count>;
+
+    buckets_t _buckets = {};
+    std::atomic<std::uint64_t> _count = 0;
+    std::atomic<std::uint64_t> _sum = 0;
+
+public:
+    void record(std::chrono::nanoseconds value) noexcept
+    {
+        auto const ns = static_cast<std::uint64_t>(
+            std::max<std::int64_t>(value.count(), 0));
+        auto const bucket = std::min<std::size_t>(
+            ns ? std::bit_width(ns) - 1 : 0,
+            histogram_snapshot::bucket_count - 1);
+
+        _buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+        _count.fetch_add(1, std::memory_order_relaxed);
+        _sum.fetch_add(ns, std::memory_order_relaxed);
+    }
+
+    histogram_snapshot snapshot() const noexcept
+    {
+        histogram_snapshot s;
+
+        for (std::size_t i = 0; i != s.bucket_count; ++i) {
+            s.buckets[i] = _buckets[i].load(std::memory_order_relaxed);
+        }
+        s.count = _count.load(std::memory_order_relaxed);
+        s.sum = _sum.load(std::memory_order_relaxed);
+
+        return s;
+    }
+};
+
+// for the histograms of the pools: an empty type when disabled
+struct histogram_disabled
+{
+    void record(std::chrono::nanoseconds) noexcept
+    {}
+
+    histogram_snapshot snapshot() const noexcept
+    {
+        return {};
+    }
+};
+
+using metrics_histogram = std::conditional_t<
+    metrics_enabled,
+    histogram,
+    histogram_disabled>;
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct worker_metrics_snapshot
+{
+    histogram_snapshot queue_wait;
+    histogram_snapshot run_time;
+    std::uint64_t tasks = 0;
+    std::uint64_t parks = 0;
+};
+
+// written by a single worker, read by snapshots
+struct worker_metrics
+{
+    histogram _queue_wait;
+    histogram _run_time;
+    std::atomic<std::uint64_t> _tasks = 0;
+    std::atomic<std::uint64_t> _parks = 0;
+
+    worker_metrics_snapshot snapshot() const noexcept
+    {
+        return {
+            .queue_wait = _queue_wait.snapshot(),
+            .run_time = _run_time.snapshot(),
+            .tasks = _tasks.load(std::memory_order_relaxed),
+            .parks = _parks.load(std::memory_order_relaxed)
+        };
+    }
+};
+
+// the metrics of the pool worker running on this thread, set by
+// thread_pool_impl; the queues count a park right before their workers wait
+inline thread_local worker_metrics* current_worker_metrics = nullptr;
+
+inline void count_park() noexcept
+{
+    if constexpr (metrics_enabled) {
+        if (current_worker_metrics) {
+            current_worker_metrics->_parks.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct priority_level_snapshot
+{
+    std::size_t depth = 0;
+    std::uint64_t tasks = 0;
+    // tasks served ahead of a more urgent level because of their age
+    std::uint64_t aged = 0;
+    histogram_snapshot queue_wait;
+};
+
+struct pool_metrics_snapshot
+{
+    std::vector<worker_metrics_snapshot> workers;
+    std::size_t queue_depth = 0;
+    // timed_thread_pool only: how late timers were handed to the workers
+    histogram_snapshot timer_lateness;
+    // priority_thread_pool only: most urgent level first
+    std::vector<priority_level_snapshot> levels;
+};
+
+}   // namespace execution
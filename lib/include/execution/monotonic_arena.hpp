@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+
+namespace execution {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// bump allocator for memory that lives as long as a single request: nothing
+// is freed until the arena is released or destroyed, so a whole pipeline
+// goes away at once. Not thread-safe.
+class monotonic_arena
+{
+private:
+    struct chunk
+    {
+        chunk* _next;
+        std::size_t _size;
+    };
+
+    std::byte* _current = nullptr;
+    std::size_t _available = 0;
+
+    chunk* _chunks = nullptr;
+    std::size_t _next_chunk_size;
+
+    // restored by release, so that a reused arena starts over
+    std::byte* _buffer = nullptr;
+    std::size_t _buffer_size = 0;
+    std::size_t _initial_chunk_size;
+
+public:
+    explicit monotonic_arena(std::size_t initial_size = 4096) noexcept;
+
+    // starts with a caller provided buffer, e.g. on the stack
+    monotonic_arena(void* buffer, std::size_t size) noexcept;
+
+    monotonic_arena(monotonic_arena const&) = delete;
+    monotonic_arena& operator = (monotonic_arena const&) = delete;
+
+    ~monotonic_arena();
+
+    void* allocate(std::size_t size, std::size_t alignment);
+
+    void deallocate(void*, std::size_t, std::size_t) noexcept
+    {}
+
+    // frees every chunk allocated by the arena and starts over with the
+    // initial buffer and chunk size
+    void release() noexcept;
+
+private:
+    void grow(std::size_t size, std::size_t alignment);
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+struct arena_allocator
+{
+    using value_type = T;
+
+    monotonic_arena* _arena;
+
+    explicit arena_allocator(monotonic_arena& arena) noexcept
+        : _arena{&arena}
+    {}
+
+    template <typename U>
+    arena_allocator(arena_allocator<U> const& other) noexcept
+        : _arena{other._arena}
+    {}
+
+    T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(_arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, std::size_t) noexcept
+    {}
+
+    template <typename U>
+    bool operator == (arena_allocator<U> const& other) const noexcept
+    {
+        return _arena == other._arena;
+    }
+};
+
+}   // namespace execution
@@ -0,0 +1,244 @@
+#pragma once
+
+#include "numa_topology.hpp"
+#include "spin_wait.hpp"
+#include "task_queue.hpp"
+#include "thread_pool_bulk.hpp"
+#include "thread_pool_impl.hpp"
+#include "thread_pool_scheduler.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace execution {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// one FIFO per node; a worker takes tasks of its own node first and steals
+// from the other nodes nearest first before it parks.
+//
+// Closed and sealed like task_queue
+class numa_task_queue
+    : public task_queue_base
+{
+private:
+    struct alignas(64) node_queue
+    {
+        std::mutex _mtx;
+        std::queue<task_base*> _tasks;
+    };
+
+    std::unique_ptr<node_queue[]> _queues;
+    std::vector<std::vector<std::size_t>> _steal_order;
+
+public:
+    explicit numa_task_queue(
+        numa_topology const& topology,
+        std::uint32_t spin_limit = adaptive_spin::default_limit);
+
+    // false once sealed
+    bool enqueue(std::size_t node, task_base* task);
+    bool enqueue_n(std::size_t node, task_base* task, std::size_t count);
+
+    // nullptr once the queue is closed and empty
+    task_base* dequeue(std::size_t node);
+    task_base* try_dequeue(std::size_t node);
+
+private:
+    task_base* try_pop_local(std::size_t node);
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+// thread pool that runs `workers_per_node` workers on each node of the
+// topology, each one restricted to the CPUs of its node. Tasks scheduled
+// from a worker stay on its node, others are spread over the nodes.
+//
+// stop() runs everything that is queued, then joins the workers; a task
+// scheduled after the workers have left runs on the calling thread
+class numa_thread_pool
+    : thread_pool_impl<numa_thread_pool>
+{
+    friend thread_pool_impl;
+
+    // the pool's workers dequeue from their own node
+    class worker_queue
+    {
+        numa_task_queue* _queue;
+
+    public:
+        explicit worker_queue(numa_task_queue& queue) noexcept
+            : _queue {&queue}
+        {}
+
+        task_base* dequeue();
+
+        std::size_t size() const noexcept
+        {
+            return _queue->size();
+        }
+    };
+
+private:
+    numa_topology _topology;
+
+    // node of each worker and the first worker of each node (plus the
+    // total at the end)
+    std::vector<std::size_t> _worker_nodes;
+    std::vector<std::size_t> _node_workers;
+
+    numa_task_queue _queue {_topology, thread_pool_impl::options().spin_limit};
+    worker_queue _worker_queue {_queue};
+
+    std::atomic<std::size_t> _next_node = 0;
+    std::atomic_flag _should_stop = {};
+    std::atomic<std::size_t> _running {thread_pool_impl::options().worker_count};
+
+public:
+    static constexpr std::size_t no_node = static_cast<std::size_t>(-1);
+
+    // all the CPUs of the machine, one worker per CPU
+    numa_thread_pool();
+
+    // `workers_per_node` == 0: one worker per CPU of the node the process
+    // may run on. Nodes without such a CPU get no worker, their tasks are
+    // stolen by the other nodes; std::system_error when no node has one.
+    // The worker count and CPUs of `options` are replaced by the ones of
+    // the topology
+    explicit numa_thread_pool(
+        numa_topology topology,
+        std::size_t workers_per_node = 0,
+        thread_pool_options options = {});
+
+    ~numa_thread_pool();
+
+    void stop();
+
+    void schedule(task_base* task);
+    void schedule_on(std::size_t node, task_base* task);
+    void schedule_on(std::size_t node, task_base* task, std::size_t count);
+
+    numa_topology const& topology() const noexcept
+    {
+        return _topology;
+    }
+
+    std::size_t node_count() const noexcept
+    {
+        return _topology.size();
+    }
+
+    // index of the node the calling worker runs on, no_node when called
+    // from a thread that doesn't belong to this pool
+    std::size_t current_node() const noexcept;
+
+    // the part of [0, shape) that bulk runs on `node`: contiguous and
+    // proportional to the number of workers of the node. Data initialized
+    // by a bulk over the same shape is first touched, and so allocated, on
+    // the node that processes it later
+    template <typename I>
+    std::pair<I, I> bulk_range(std::size_t node, I shape) const noexcept
+    {
+        auto const total = _worker_nodes.size();
+        auto const bound = [&] (std::size_t n) {
+            return static_cast<I>(
+                static_cast<unsigned long long>(shape) * _node_workers[n] / total);
+        };
+
+        return {bound(node), bound(node + 1)};
+    }
+
+    using thread_pool_impl::metrics;
+    using thread_pool_impl::options;
+    using thread_pool_impl::size;
+
+    thread_pool_scheduler<numa_thread_pool> get_scheduler()
+    {
+        return {this};
+    }
+
+private:
+    void init_worker(std::size_t index);
+    void exit_worker(std::size_t index);
+
+    worker_queue& get_queue()
+    {
+        return _worker_queue;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace thread_pool_bulk_impl {
+
+// every node runs its bulk_range of the indices; a worker that runs out of
+// local indices (it stole a task of another node) takes one from the next
+// node that still has some
+template <typename I>
+struct bulk_dispatch<numa_thread_pool, I>
+{
+    struct alignas(64) range
+    {
+        std::atomic<I> _next;
+        I _begin;
+        I _end;
+    };
+
+    std::unique_ptr<range[]> _ranges;
+    std::size_t _node_count;
+
+    bulk_dispatch(numa_thread_pool* pool, I shape)
+        : _ranges {std::make_unique<range[]>(pool->node_count())}
+        , _node_count {pool->node_count()}
+    {
+        for (std::size_t n = 0; n != _node_count; ++n) {
+            auto const [first, last] = pool->bulk_range(n, shape);
+            _ranges[n]._next.store(first, std::memory_order_relaxed);
+            _ranges[n]._begin = first;
+            _ranges[n]._end = last;
+        }
+    }
+
+    void schedule(numa_thread_pool* pool, task_base* task, I shape)
+    {
+        auto* ranges = _ranges.get();
+
+        // nothing of *this is touched after the last task is queued
+        for (std::size_t n = 0; shape != I{}; ++n) {
+            I const count = ranges[n]._end - ranges[n]._begin;
+            if (count != I{}) {
+                shape -= count;
+                pool->schedule_on(n, task, static_cast<std::size_t>(count));
+            }
+        }
+    }
+
+    I next(numa_thread_pool* pool)
+    {
+        auto const node = pool->current_node();
+        auto const first = node == numa_thread_pool::no_node ? 0 : node;
+
+        for (std::size_t k = 0; k != _node_count; ++k) {
+            auto& r = _ranges[(first + k) % _node_count];
+            if (r._next.load(std::memory_order_relaxed) < r._end) {
+                I const i = r._next.fetch_add(1);
+                if (i < r._end) {
+                    return i;
+                }
+            }
+        }
+
+        // unreachable: there are as many executions as indices
+        return {};
+    }
+};
+
+}   // namespace thread_pool_bulk_impl
+
+}   // namespace execution
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+namespace execution {
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct numa_node
+{
+    // id of the node in the system, e.g. 1 for /sys/devices/system/node/node1
+    int id = 0;
+
+    std::vector<int> cpus;
+
+    // relative access cost to every node of the topology, indexed like
+    // numa_topology::nodes(); 10 is local memory
+    std::vector<int> distances;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+class numa_topology
+{
+private:
+    std::vector<numa_node> _nodes;
+
+public:
+    explicit numa_topology(std::vector<numa_node> nodes);
+
+    // reads the nodes that have CPUs from sysfs; falls back to a single node
+    // with all the hardware threads when the directory doesn't exist
+    static numa_topology discover(
+        std::filesystem::path const& root = "/sys/devices/system/node");
+
+    // one node with `cpu_count` CPUs
+    static numa_topology uniform(std::size_t cpu_count);
+
+    std::vector<numa_node> const& nodes() const noexcept
+    {
+        return _nodes;
+    }
+
+    std::size_t size() const noexcept
+    {
+        return _nodes.size();
+    }
+
+    // the other nodes of the topology ordered by distance from `node`
+    std::vector<std::size_t> neighbours(std::size_t node) const;
+};
+
+// parses a sysfs cpu list such as "0-3,8,10-11"
+std::vector<int> parse_cpu_list(std::string_view str);
+
+}   // namespace execution
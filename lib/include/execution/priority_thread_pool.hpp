@@ -0,0 +1,239 @@
+#pragma once
+
+#include "metrics.hpp"
+#include "spin_wait.hpp"
+#include "task_queue.hpp"
+#include "thread_options.hpp"
+#include "thread_pool_impl.hpp"
+#include "thread_pool_scheduler.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace execution {
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct priority_options
+{
+    // level 0 is the most urgent
+    std::size_t levels = 8;
+
+    // level of the tasks scheduled without a priority
+    std::size_t default_level = 4;
+
+    // a waiting task is served as if it were one level more urgent for
+    // every `aging_period` tasks the pool dequeues, so that no level
+    // starves; 0: strict priorities
+    std::size_t aging_period = 64;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+// one FIFO per level. A worker takes the head whose level, lowered by its
+// age, is the most urgent; the oldest one on a tie.
+//
+// Closed and sealed like task_queue
+class multilevel_task_queue
+    : public task_queue_base
+{
+private:
+    struct entry
+    {
+        task_base* _task;
+        std::uint64_t _seq;
+    };
+
+    // the metrics of a level: an empty type when disabled
+    struct level_metrics_enabled
+    {
+        std::uint64_t _dequeued = 0;
+        std::uint64_t _aged = 0;
+        histogram _queue_wait;
+
+        // `aged`: served ahead of a more urgent level
+        void record(task_base* task, bool aged) noexcept
+        {
+            ++_dequeued;
+            _aged += aged;
+            _queue_wait.record(metrics_clock_t::now() - task->_enqueued_at.get());
+        }
+
+        void snapshot(priority_level_snapshot& s) const noexcept
+        {
+            s.tasks = _dequeued;
+            s.aged = _aged;
+            s.queue_wait = _queue_wait.snapshot();
+        }
+    };
+
+    struct level_metrics_disabled
+    {
+        void record(task_base*, bool) noexcept
+        {}
+
+        void snapshot(priority_level_snapshot&) const noexcept
+        {}
+    };
+
+    struct level
+    {
+        std::deque<entry> _tasks;
+
+        [[ no_unique_address ]] std::conditional_t<
+            metrics_enabled,
+            level_metrics_enabled,
+            level_metrics_disabled> _metrics;
+    };
+
+    priority_options _options;
+    std::unique_ptr<level[]> _levels;
+
+    // tasks dequeued so far: the clock of the aging
+    std::uint64_t _served = 0;
+
+public:
+    explicit multilevel_task_queue(
+        priority_options const& options,
+        std::uint32_t spin_limit = adaptive_spin::default_limit);
+
+    std::size_t levels() const noexcept
+    {
+        return _options.levels;
+    }
+
+    std::size_t default_level() const noexcept
+    {
+        return _options.default_level;
+    }
+
+    // `priority` is clamped to the least urgent level; false once sealed
+    bool enqueue(std::size_t priority, task_base* task);
+    bool enqueue_n(std::size_t priority, task_base* task, std::size_t count);
+
+    // nullptr once the queue is closed and empty
+    task_base* dequeue();
+    task_base* try_dequeue();
+
+    // most urgent level first
+    std::vector<priority_level_snapshot> level_metrics();
+
+private:
+    task_base* pop();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+class priority_thread_pool;
+
+namespace priority_thread_pool_impl {
+
+template <typename T>
+struct sender
+{
+    T* _pool;
+    std::size_t _priority;
+
+    template <typename R>
+    auto connect(R&& receiver) const
+    {
+        return thread_pool_scheduler_impl::operation {
+            [pool = _pool, p = _priority] (auto* task) {
+                pool->schedule(p, task);
+            },
+            std::forward<R>(receiver)
+        };
+    }
+};
+
+template <typename T>
+struct scheduler
+{
+    T* _pool;
+    std::size_t _priority;
+
+    auto schedule() const -> sender<T>
+    {
+        return {_pool, _priority};
+    }
+
+    // the same pool, scheduling at level `priority`
+    scheduler with_priority(std::size_t priority) const noexcept
+    {
+        return {_pool, priority};
+    }
+
+    std::size_t priority() const noexcept
+    {
+        return _priority;
+    }
+
+    bool operator == (scheduler const&) const noexcept = default;
+};
+
+}   // namespace priority_thread_pool_impl
+
+template <typename T, typename R>
+struct sender_traits<priority_thread_pool_impl::sender<T>, R>
+    : thread_pool_scheduler_impl::sender_traits_base<priority_thread_pool_impl::sender<T>, R>
+{
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+// thread pool with user-facing priorities:
+// `schedule(pool.get_scheduler().with_priority(p))`
+//
+// stop() runs everything that is queued, then joins the workers; a task
+// scheduled after the workers have left runs on the calling thread
+class priority_thread_pool
+    : thread_pool_impl<priority_thread_pool>
+{
+    friend thread_pool_impl;
+
+public:
+    using scheduler_t = priority_thread_pool_impl::scheduler<priority_thread_pool>;
+
+private:
+    multilevel_task_queue _queue;
+    std::atomic_flag _should_stop = {};
+    std::atomic<std::size_t> _running;
+
+public:
+    explicit priority_thread_pool(std::size_t worker_count);
+    priority_thread_pool(thread_pool_options options, priority_options const& priorities);
+    ~priority_thread_pool();
+
+    void stop();
+
+    void schedule(task_base* task);
+    void schedule(std::size_t priority, task_base* task);
+    void schedule_n(task_base* task, std::size_t count);
+
+    std::size_t levels() const noexcept
+    {
+        return _queue.levels();
+    }
+
+    // with the per level metrics
+    pool_metrics_snapshot metrics();
+
+    using thread_pool_impl::options;
+
+    scheduler_t get_scheduler() noexcept;
+
+private:
+    multilevel_task_queue& get_queue()
+    {
+        return _queue;
+    }
+
+    void exit_worker(std::size_t index);
+};
+
+}   // namespace execution
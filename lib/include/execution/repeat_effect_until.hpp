@@ -3,6 +3,7 @@
 #include "customization.hpp"
 #include "pipeable.hpp"
 #include "sender_traits.hpp"
+#include "trace.hpp"
 
 #include <optional>
 
@@ -95,7 +96,15 @@ struct operation
     {
         _state.reset();
 
-        if (std::invoke(_condition)) {
+        auto const tracer = execution::get_tracer(_receiver);
+        tracer.async_end("repeat_effect_until", this);
+
+        auto&& condition = execution::trace_call(
+            tracer,
+            "repeat_effect_until.condition",
+            _condition);
+
+        if (std::invoke(condition)) {
             execution::set_value(std::move(_receiver));
         } else {
             restart();
@@ -106,12 +115,14 @@ struct operation
     void set_error(E&& error)
     {
         _state.reset();
+        execution::get_tracer(_receiver).async_end("repeat_effect_until", this);
         execution::set_error(std::move(_receiver), std::forward<E>(error));
     }
 
     void set_stopped()
     {
         _state.reset();
+        execution::get_tracer(_receiver).async_end("repeat_effect_until", this);
         execution::set_stopped(std::move(_receiver));
     }
 
@@ -122,6 +133,7 @@ struct operation
 
     void restart()
     {
+        execution::get_tracer(_receiver).async_begin("repeat_effect_until", this);
         _state.emplace(execution::connect(_source, source_receiver_t{this}));
         _state->start();
     }
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "task_queue.hpp"
+#include "thread_pool_scheduler.hpp"
+
+#include <condition_variable>
+#include <mutex>
+
+namespace execution {
+
+class run_loop;
+
+namespace run_loop_impl {
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct scheduler
+{
+    run_loop* _loop;
+
+    auto schedule() const -> thread_pool_scheduler_impl::sender<run_loop>
+    {
+        return {_loop};
+    }
+
+    bool operator == (scheduler const&) const noexcept = default;
+};
+
+}   // namespace run_loop_impl
+
+////////////////////////////////////////////////////////////////////////////////
+
+// single threaded execution context driven by the thread that calls run():
+// tasks are executed in FIFO order until finish() is called and the queue
+// is drained
+class run_loop
+{
+private:
+    std::mutex _mtx;
+    std::condition_variable _cv;
+
+    task_base* _head = nullptr;
+    task_base* _tail = nullptr;
+    bool _finishing = false;
+
+public:
+    run_loop() = default;
+
+    run_loop(run_loop const&) = delete;
+    run_loop& operator = (run_loop const&) = delete;
+
+    ~run_loop();
+
+    void schedule(task_base* task);
+
+    void run();
+    void finish();
+
+    run_loop_impl::scheduler get_scheduler()
+    {
+        return {this};
+    }
+
+private:
+    task_base* dequeue();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+using run_loop_scheduler = run_loop_impl::scheduler;
+
+}   // namespace execution
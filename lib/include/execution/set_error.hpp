@@ -2,6 +2,9 @@
 
 #include "customization.hpp"
 
+#include <exception>
+#include <system_error>
+#include <type_traits>
 #include <utility>
 
 namespace execution {
@@ -32,4 +35,19 @@ inline constexpr struct set_error_fn
 
 using set_error_t = set_error_fn;
 
+////////////////////////////////////////////////////////////////////////////////
+
+// for consumers that can only report std::exception_ptr
+template <typename E>
+std::exception_ptr as_exception_ptr(E&& error) noexcept
+{
+    if constexpr (std::is_same_v<std::decay_t<E>, std::exception_ptr>) {
+        return std::forward<E>(error);
+    } else if constexpr (std::is_same_v<std::decay_t<E>, std::error_code>) {
+        return std::make_exception_ptr(std::system_error{error});
+    } else {
+        return std::make_exception_ptr(std::forward<E>(error));
+    }
+}
+
 }   // namespace execution
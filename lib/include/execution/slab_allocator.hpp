@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+namespace execution {
+namespace slab_impl {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// blocks are rounded up to powers of two in [min_block_size, max_block_size],
+// larger requests go straight to the global heap
+inline constexpr std::size_t min_block_size = 16;
+inline constexpr std::size_t max_block_size = 128 * 1024;
+
+// blocks a thread keeps for reuse per size class, the rest is freed
+inline constexpr std::size_t max_cached_blocks = 64;
+
+void* allocate(std::size_t size);
+void deallocate(void* ptr, std::size_t size) noexcept;
+
+}   // namespace slab_impl
+
+////////////////////////////////////////////////////////////////////////////////
+
+// recycles freed blocks through a thread-local cache of size classes: once
+// the cache is warm, allocating and freeing operation states of the same
+// size doesn't hit the global heap. A block freed on another thread goes to
+// that thread's cache.
+template <typename T>
+struct slab_allocator
+{
+    using value_type = T;
+
+    slab_allocator() noexcept = default;
+
+    template <typename U>
+    slab_allocator(slab_allocator<U> const&) noexcept
+    {}
+
+    T* allocate(std::size_t n)
+    {
+        if constexpr (alignof(T) > alignof(std::max_align_t)) {
+            return std::allocator<T>{}.allocate(n);
+        } else {
+            return static_cast<T*>(slab_impl::allocate(n * sizeof(T)));
+        }
+    }
+
+    void deallocate(T* ptr, std::size_t n) noexcept
+    {
+        if constexpr (alignof(T) > alignof(std::max_align_t)) {
+            std::allocator<T>{}.deallocate(ptr, n);
+        } else {
+            slab_impl::deallocate(ptr, n * sizeof(T));
+        }
+    }
+
+    template <typename U>
+    bool operator == (slab_allocator<U> const&) const noexcept
+    {
+        return true;
+    }
+};
+
+}   // namespace execution
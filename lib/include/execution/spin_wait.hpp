@@ -0,0 +1,95 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace execution {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// tells the CPU that the thread busy waits: saves power and lets the other
+// hyper-thread of the core run
+inline void cpu_relax() noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__ ("yield");
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+// busy waits for a condition before the caller parks on a condition
+// variable. The number of spins follows the waits that succeeded: it grows
+// towards twice the spins they needed and decays when spinning is in vain,
+// so an idle pool soon parks right away while a busy one rarely parks
+class adaptive_spin
+{
+public:
+    static constexpr std::uint32_t default_limit = 1024;
+
+private:
+    static constexpr std::uint32_t min_spins = 16;
+    static constexpr std::uint32_t yields = 4;
+
+    std::uint32_t _max;
+    std::atomic<std::uint32_t> _spins;
+
+public:
+    // `max_spins` == 0: never waits. Neither does it on a single CPU, where
+    // nobody else makes progress while the thread waits
+    explicit adaptive_spin(std::uint32_t max_spins = default_limit) noexcept
+        : _max {std::thread::hardware_concurrency() == 1 ? 0 : max_spins}
+        , _spins {std::min(_max, min_spins)}
+    {}
+
+    // true if `ready` returned true before the interval elapsed
+    template <typename F>
+    bool wait(F&& ready) noexcept
+    {
+        if (!_max) {
+            return false;
+        }
+
+        auto const spins = _spins.load(std::memory_order_relaxed);
+
+        for (std::uint32_t i = 0; i != spins; ++i) {
+            if (ready()) {
+                adapt(spins, 2 * i + min_spins);
+                return true;
+            }
+            cpu_relax();
+        }
+
+        for (std::uint32_t i = 0; i != yields; ++i) {
+            std::this_thread::yield();
+            if (ready()) {
+                adapt(spins, 2 * spins + min_spins);
+                return true;
+            }
+        }
+
+        adapt(spins, 0);
+        return false;
+    }
+
+private:
+    // moves an eighth of the way towards `target`; concurrent updates may
+    // be lost, which only delays the adaptation
+    void adapt(std::uint32_t spins, std::uint32_t target) noexcept
+    {
+        auto const next = static_cast<std::int64_t>(spins)
+            + (static_cast<std::int64_t>(target) - spins) / 8;
+
+        auto const low = std::min(_max, min_spins);
+
+        _spins.store(
+            static_cast<std::uint32_t>(std::clamp<std::int64_t>(next, low, _max)),
+            std::memory_order_relaxed);
+    }
+};
+
+}   // namespace execution
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "get_allocator.hpp"
 #include "sender_traits.hpp"
 
 #include <exception>
@@ -13,9 +14,11 @@ namespace start_detached_impl {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+template <typename A>
 struct receiver
 {
     std::shared_ptr<void> _storage;
+    [[ no_unique_address ]] A _allocator;
 
     void set_value()
     {
@@ -32,6 +35,14 @@ struct receiver
     {
         std::terminate();
     }
+
+    // tag_invoke
+
+    friend auto tag_invoke(tag_t<get_allocator>, const receiver<A>& self) noexcept
+        -> A
+    {
+        return self._allocator;
+    }
 };
 
 struct start_detached
@@ -39,8 +50,18 @@ struct start_detached
     template <typename S>
     void operator () (S&& sender) const
     {
+        (*this)(std::forward<S>(sender), std::allocator<std::byte>{});
+    }
+
+    // the operation state is allocated with `allocator`, which is also
+    // handed to the algorithms of `sender` through get_allocator
+    template <typename S, typename A>
+    void operator () (S&& sender, A const& allocator) const
+    {
+        using receiver_t = receiver<A>;
+
         constexpr auto sender_type = meta::atom<std::decay_t<S>>{};
-        constexpr auto receiver_type = meta::atom<receiver>{};
+        constexpr auto receiver_type = meta::atom<receiver_t>{};
         constexpr auto value_types = traits::sender_values(
             sender_type, receiver_type);
         constexpr auto operation_type = traits::sender_operation(
@@ -50,10 +71,13 @@ struct start_detached
 
         using operation_t = typename decltype(operation_type)::type;
 
-        auto s = std::make_shared<std::optional<operation_t>>();
+        using storage_t = std::optional<operation_t>;
+
+        auto s = std::allocate_shared<storage_t>(
+            rebind_allocator_t<A, storage_t>{allocator});
 
         auto& op = s->emplace(
-            execution::connect(std::forward<S>(sender), receiver{s}));
+            execution::connect(std::forward<S>(sender), receiver_t{s, allocator}));
 
         execution::start(op);
     }
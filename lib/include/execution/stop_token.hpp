@@ -1,7 +1,9 @@
 #pragma once
 
 #include "customization.hpp"
+#include "inplace_stop_token.hpp"
 
+#include <concepts>
 #include <stop_token>
 #include <type_traits>
 
@@ -9,6 +11,51 @@ namespace execution {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+template <typename T>
+concept stoppable_token = std::copyable<T>
+    && std::equality_comparable<T>
+    && requires (T const& token) {
+        { token.stop_requested() } noexcept -> std::convertible_to<bool>;
+        { token.stop_possible() } noexcept -> std::convertible_to<bool>;
+    };
+
+template <typename T>
+concept unstoppable_token = stoppable_token<T>
+    && requires {
+        requires std::bool_constant<(!T{}.stop_possible())>::value;
+    };
+
+////////////////////////////////////////////////////////////////////////////////
+
+// token of receivers that never request stop: algorithms can check it at
+// compile time and skip callback registration altogether
+class never_stop_token
+{
+    struct callback
+    {
+        explicit callback(never_stop_token, auto&&) noexcept
+        {}
+    };
+
+public:
+    template <typename F>
+    using callback_type = callback;
+
+    static constexpr bool stop_requested() noexcept
+    {
+        return false;
+    }
+
+    static constexpr bool stop_possible() noexcept
+    {
+        return false;
+    }
+
+    constexpr bool operator == (never_stop_token const&) const noexcept = default;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
 inline constexpr struct get_stop_token_fn
 {
     // default implementation
@@ -16,7 +63,7 @@ inline constexpr struct get_stop_token_fn
         requires (!is_tag_invocable_v<get_stop_token_fn, R>)
     auto operator () (R&&) const noexcept
     {
-        return std::stop_token{};
+        return never_stop_token{};
     }
 
     template <typename R>
@@ -29,4 +76,25 @@ inline constexpr struct get_stop_token_fn
 
 } get_stop_token;
 
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename R>
+using stop_token_of_t = std::remove_cvref_t<
+    decltype(execution::get_stop_token(std::declval<R const&>()))>;
+
+template <typename T, typename F>
+struct stop_callback_for
+{
+    using type = typename T::template callback_type<F>;
+};
+
+template <typename F>
+struct stop_callback_for<std::stop_token, F>
+{
+    using type = std::stop_callback<F>;
+};
+
+template <typename T, typename F>
+using stop_callback_for_t = typename stop_callback_for<T, F>::type;
+
 }   // namespace execution
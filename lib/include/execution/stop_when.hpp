@@ -41,6 +41,7 @@ struct source_receiver
     // tag_invoke
 
     friend auto tag_invoke(tag_t<get_stop_token>, const source_receiver<S, T, R>& self) noexcept
+        -> inplace_stop_token
     {
         return self._operation->get_stop_token();
     }
@@ -81,6 +82,7 @@ struct trigger_receiver
     // tag_invoke
 
     friend auto tag_invoke(tag_t<get_stop_token>, const trigger_receiver<S, T, R>& self) noexcept
+        -> inplace_stop_token
     {
         return self._operation->get_stop_token();
     }
@@ -127,13 +129,17 @@ class operation
         }
     };
 
+    using stop_callback_t = stop_callback_for_t<
+        stop_token_of_t<R>,
+        cancel_callback>;
+
     struct operations
     {
         source_operation_t _source;
         trigger_operation_t _trigger;
-        std::stop_callback<cancel_callback> _stop_callback;
+        stop_callback_t _stop_callback;
 
-        std::stop_source _stop_source;
+        inplace_stop_source _stop_source;
         std::atomic<int> _active_ops = 2;
 
         operations(auto&& src, auto&& tgr, auto&& token, cancel_callback cb)
@@ -1,15 +1,17 @@
 #pragma once
 
+#include "get_scheduler.hpp"
 #include "null_receiver.hpp"
 #include "pipeable.hpp"
+#include "run_loop.hpp"
 #include "sender_traits.hpp"
-#include "tuple.hpp"
 #include "stop_token.hpp"
+#include "tuple.hpp"
 
 #include <exception>
-#include <future>
 #include <optional>
 #include <system_error>
+#include <variant>
 
 namespace this_thread {
 namespace sync_wait_impl {
@@ -18,54 +20,89 @@ using namespace execution;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+template <typename T>
+struct state
+{
+    run_loop _loop;
+    inplace_stop_source _stop_source;
+    std::variant<std::monostate, T, std::exception_ptr> _result;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
 template <typename T>
 struct receiver
 {
-    std::promise<T>& _promise;
-    std::stop_source _stop_source;
+    state<T>* _state;
 
     template <typename ... Ts>
     void set_value(Ts&& ... values)
     {
-        _promise.set_value(decayed_tuple_t<Ts...>{std::forward<Ts>(values)...});
+        try {
+            _state->_result.template emplace<1>(
+                decayed_tuple_t<Ts...>{std::forward<Ts>(values)...});
+        } catch (...) {
+            _state->_result.template emplace<2>(std::current_exception());
+        }
+        _state->_loop.finish();
     }
 
     void set_error(std::exception_ptr ex)
     {
-        _promise.set_exception(std::move(ex));
+        _state->_result.template emplace<2>(std::move(ex));
+        _state->_loop.finish();
     }
 
     void set_error(std::error_code ec)
     {
-        _promise.set_exception(std::make_exception_ptr(
-            std::system_error{ec}));
+        set_error(std::make_exception_ptr(std::system_error{ec}));
     }
 
     template <typename E>
     void set_error(E&& error)
     {
-        _promise.set_exception(std::make_exception_ptr(std::forward<E>(error)));
+        set_error(std::make_exception_ptr(std::forward<E>(error)));
     }
 
     void set_stopped()
     {
-        _promise.set_value(std::nullopt);
+        _state->_result.template emplace<1>(std::nullopt);
+        _state->_loop.finish();
     }
 
     // tag_invoke
 
     friend auto tag_invoke(tag_t<get_stop_token>, const receiver<T>& self) noexcept
+        -> inplace_stop_token
+    {
+        return self._state->_stop_source.get_token();
+    }
+
+    friend auto tag_invoke(tag_t<get_scheduler>, const receiver<T>& self) noexcept
+        -> run_loop_scheduler
     {
-        return self._stop_source.get_token();
+        return self._state->_loop.get_scheduler();
     }
 };
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename T, typename ... Ts>
+struct forward_stop_request
+{
+    inplace_stop_source& _stop_source;
+
+    void operator () () noexcept
+    {
+        _stop_source.request_stop();
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename T, stoppable_token St, typename ... Ts>
 auto do_sync_wait(
     T&& sender,
-    std::stop_source ss,
+    St token,
     meta::atom<signature<Ts...>> expected_result_type)
 {
     using result_t = std::optional<decayed_tuple_t<Ts...>>;
@@ -81,17 +118,27 @@ auto do_sync_wait(
 
     static_assert(meta::contains(value_types, expected_result_type));
 
-    std::promise<result_t> promise;
-    auto future = promise.get_future();
+    state<result_t> state;
+
+    stop_callback_for_t<St, forward_stop_request> stop_callback {
+        std::move(token),
+        forward_stop_request{state._stop_source}
+    };
 
     operation_t op {connect(
         std::forward<T>(sender),
-        receiver<result_t>{promise, std::move(ss)}
+        receiver<result_t>{&state}
     )};
 
     start(op);
 
-    return future.get();
+    state._loop.run();
+
+    if (state._result.index() == 2) {
+        std::rethrow_exception(std::get<2>(std::move(state._result)));
+    }
+
+    return std::get<1>(std::move(state._result));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -104,23 +151,36 @@ struct sync_wait_r
         return pipeable(*this);
     }
 
-    auto operator () (std::stop_source ss) const
+    template <stoppable_token St>
+    auto operator () (St token) const
     {
-        return pipeable(*this, std::move(ss));
+        return pipeable(*this, std::move(token));
+    }
+
+    auto operator () (std::stop_source const& ss) const
+    {
+        return pipeable(*this, ss.get_token());
     }
 
     template <typename T>
+        requires (!stoppable_token<std::decay_t<T>>)
     auto operator () (T&& sender) const
     {
-        return sync_wait_r{}(std::forward<T>(sender), std::stop_source{});
+        return sync_wait_r{}(std::forward<T>(sender), never_stop_token{});
     }
 
     template <typename T>
-    auto operator () (T&& sender, std::stop_source ss) const
+    auto operator () (T&& sender, std::stop_source const& ss) const
+    {
+        return sync_wait_r{}(std::forward<T>(sender), ss.get_token());
+    }
+
+    template <typename T, stoppable_token St>
+    auto operator () (T&& sender, St token) const
     {
         return do_sync_wait(
             std::forward<T>(sender),
-            std::move(ss),
+            std::move(token),
             meta::atom<signature<Ts...>>{}
         );
     }
@@ -135,19 +195,32 @@ struct sync_wait
         return pipeable(*this);
     }
 
-    auto operator () (std::stop_source ss) const
+    template <stoppable_token St>
+    auto operator () (St token) const
+    {
+        return pipeable(*this, std::move(token));
+    }
+
+    auto operator () (std::stop_source const& ss) const
     {
-        return pipeable(*this, std::move(ss));
+        return pipeable(*this, ss.get_token());
     }
 
     template <typename T>
+        requires (!stoppable_token<std::decay_t<T>>)
     auto operator () (T&& sender) const
     {
-        return sync_wait{}(std::forward<T>(sender), std::stop_source{});
+        return sync_wait{}(std::forward<T>(sender), never_stop_token{});
     }
 
     template <typename T>
-    auto operator () (T&& sender, std::stop_source ss) const
+    auto operator () (T&& sender, std::stop_source const& ss) const
+    {
+        return sync_wait{}(std::forward<T>(sender), ss.get_token());
+    }
+
+    template <typename T, stoppable_token St>
+    auto operator () (T&& sender, St token) const
     {
         constexpr auto sender_type = meta::atom<std::decay_t<T>>{};
         constexpr auto receiver_type = meta::atom<null_receiver>{};
@@ -159,7 +232,7 @@ struct sync_wait
 
         return do_sync_wait(
             std::forward<T>(sender),
-            std::move(ss),
+            std::move(token),
             value_types.head
         );
     }
@@ -0,0 +1,730 @@
+#pragma once
+
+#include "get_allocator.hpp"
+#include "inplace_stop_token.hpp"
+#include "sender_traits.hpp"
+#include "stop_token.hpp"
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <new>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace execution {
+
+template <typename T = void>
+class task;
+
+namespace task_impl {
+
+////////////////////////////////////////////////////////////////////////////////
+// frame allocation
+
+// the allocator of a frame is stored right before it together with the
+// function that frees the frame, so operator delete doesn't need to know
+// the size of the frame nor which allocator the coroutine was created with
+using deallocate_t = void (*)(void* frame) noexcept;
+
+struct alignas(std::max_align_t) frame_unit
+{
+    std::byte _data[alignof(std::max_align_t)];
+};
+
+constexpr std::size_t align_up(std::size_t size, std::size_t alignment) noexcept
+{
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+template <typename A>
+struct frame_header
+{
+    std::size_t _units;
+    A _allocator;
+};
+
+// the header ends right before the deallocate function, which ends right
+// before the frame
+template <typename A>
+constexpr std::size_t header_offset = align_up(
+    sizeof(deallocate_t) + sizeof(frame_header<A>),
+    alignof(frame_header<A>));
+
+template <typename A>
+constexpr std::size_t header_units =
+    align_up(header_offset<A>, sizeof(frame_unit)) / sizeof(frame_unit);
+
+template <typename A>
+void deallocate_frame(void* frame) noexcept
+{
+    auto* bytes = static_cast<std::byte*>(frame);
+    auto* header = std::launder(reinterpret_cast<frame_header<A>*>(
+        bytes - header_offset<A>));
+
+    auto const units = header->_units;
+    A allocator {std::move(header->_allocator)};
+    header->~frame_header<A>();
+
+    allocator.deallocate(static_cast<frame_unit*>(frame) - header_units<A>, units);
+}
+
+template <typename A>
+void* allocate_frame(std::size_t size, A const& allocator)
+{
+    using allocator_t = rebind_allocator_t<A, frame_unit>;
+
+    allocator_t frame_allocator {allocator};
+
+    auto const units = header_units<allocator_t>
+        + align_up(size, sizeof(frame_unit)) / sizeof(frame_unit);
+
+    auto* frame = reinterpret_cast<std::byte*>(
+        frame_allocator.allocate(units) + header_units<allocator_t>);
+
+    ::new (frame - header_offset<allocator_t>) frame_header<allocator_t>{
+        units,
+        std::move(frame_allocator)
+    };
+    ::new (frame - sizeof(deallocate_t)) deallocate_t{
+        &deallocate_frame<allocator_t>
+    };
+
+    return frame;
+}
+
+inline void deallocate_frame(void* frame) noexcept
+{
+    auto* bytes = static_cast<std::byte*>(frame);
+    auto const deallocate = *std::launder(reinterpret_cast<deallocate_t*>(
+        bytes - sizeof(deallocate_t)));
+
+    deallocate(frame);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename A>
+concept awaitable = requires (A&& a) {
+    std::forward<A>(a).operator co_await();
+} || requires (A& a) {
+    a.await_ready();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct promise_base
+{
+    // the coroutine itself: its promise is a frame_promise derived from
+    // this one
+    std::coroutine_handle<> _coroutine;
+
+    // set when the task is awaited by another coroutine
+    std::coroutine_handle<> _continuation;
+
+    // set when the task is connected to a receiver
+    void (*_complete)(void*) noexcept = nullptr;
+
+    // the coroutine to resume when an awaited sender completes with
+    // set_stopped: the stop request unwinds to the operation at the root
+    std::coroutine_handle<> (*_unhandled_stopped)(void*) noexcept = nullptr;
+    void* _parent = nullptr;
+
+    inplace_stop_token _stop_token;
+
+    std::coroutine_handle<> unhandled_stopped() noexcept
+    {
+        return _unhandled_stopped(_parent);
+    }
+
+    std::suspend_always initial_suspend() noexcept
+    {
+        return {};
+    }
+
+    struct final_awaiter
+    {
+        bool await_ready() noexcept
+        {
+            return false;
+        }
+
+        template <typename P>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) noexcept
+        {
+            promise_base& p = h.promise();
+
+            if (p._continuation) {
+                return p._continuation;
+            }
+
+            p._complete(p._parent);
+            return std::noop_coroutine();
+        }
+
+        void await_resume() noexcept
+        {}
+    };
+
+    final_awaiter final_suspend() noexcept
+    {
+        return {};
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// co_await sender
+
+// a sender that completes inline, inside of start(), doesn't resume the
+// coroutine itself but lets await_suspend return false instead, so a loop
+// of synchronous co_awaits doesn't grow the stack
+struct inline_completion
+{
+    void const* _awaitable;
+    bool _completed;
+};
+
+inline thread_local inline_completion* current_inline_completion = nullptr;
+
+template <typename S>
+struct sender_awaitable;
+
+template <typename S>
+struct awaitable_receiver
+{
+    sender_awaitable<S>* _awaitable;
+
+    template <typename ... Ts>
+    void set_value(Ts&& ... values)
+    {
+        _awaitable->set_value(std::forward<Ts>(values)...);
+    }
+
+    template <typename E>
+    void set_error(E&& error)
+    {
+        _awaitable->set_error(std::forward<E>(error));
+    }
+
+    void set_stopped()
+    {
+        _awaitable->set_stopped();
+    }
+
+    // tag_invoke
+
+    friend auto tag_invoke(tag_t<get_stop_token>, const awaitable_receiver<S>& self) noexcept
+        -> inplace_stop_token
+    {
+        return self._awaitable->_promise->_stop_token;
+    }
+};
+
+template <typename S>
+struct sender_awaitable
+{
+    using receiver_t = awaitable_receiver<S>;
+
+    static constexpr auto sender_type = meta::atom<S>{};
+    static constexpr auto receiver_type = meta::atom<receiver_t>{};
+    static constexpr auto value_types = traits::sender_values(
+        sender_type,
+        receiver_type);
+
+    static_assert(value_types.size <= 1,
+        "co_await: sender must complete with a single set of values");
+
+    static constexpr auto as_value = [] <typename ... Ts> (meta::atom<signature<Ts...>>) {
+        if constexpr (sizeof ... (Ts) == 0) {
+            return meta::atom<void>{};
+        } else if constexpr (sizeof ... (Ts) == 1) {
+            return meta::atom<std::decay_t<Ts>...>{};
+        } else {
+            return meta::atom<std::tuple<std::decay_t<Ts>...>>{};
+        }
+    };
+
+    using value_t = typename decltype([] {
+        if constexpr (value_types.size == 0) {
+            return meta::atom<void>{};
+        } else {
+            return as_value(value_types.head);
+        }
+    } ())::type;
+
+    using result_t = std::variant<
+        std::monostate,
+        std::conditional_t<std::is_void_v<value_t>, std::tuple<>, value_t>,
+        std::exception_ptr>;
+
+    using operation_t = typename decltype(
+        traits::sender_operation(sender_type, receiver_type))::type;
+
+    promise_base* _promise;
+    std::coroutine_handle<> _handle;
+
+    result_t _result;
+    bool _stopped = false;
+
+    operation_t _operation;
+
+    template <typename Sx>
+    sender_awaitable(Sx&& sender, promise_base& promise, std::coroutine_handle<> handle)
+        : _promise{&promise}
+        , _handle{handle}
+        , _operation(execution::connect(std::forward<Sx>(sender), receiver_t{this}))
+    {}
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    bool await_suspend(std::coroutine_handle<>) noexcept
+    {
+        inline_completion completion {this, false};
+        auto* prev = std::exchange(current_inline_completion, &completion);
+
+        execution::start(_operation);
+
+        current_inline_completion = prev;
+
+        // otherwise the coroutine may have been resumed (and even destroyed)
+        // by another thread already
+        if (!completion._completed) {
+            return true;
+        }
+
+        if (_stopped) {
+            _promise->unhandled_stopped().resume();
+            return true;
+        }
+
+        return false;
+    }
+
+    value_t await_resume()
+    {
+        if (_result.index() == 2) {
+            std::rethrow_exception(std::get<2>(std::move(_result)));
+        }
+
+        if constexpr (!std::is_void_v<value_t>) {
+            return std::get<1>(std::move(_result));
+        }
+    }
+
+    template <typename ... Ts>
+    void set_value(Ts&& ... values)
+    {
+        try {
+            _result.template emplace<1>(std::forward<Ts>(values)...);
+        } catch (...) {
+            _result.template emplace<2>(std::current_exception());
+        }
+
+        complete();
+    }
+
+    template <typename E>
+    void set_error(E&& error)
+    {
+        _result.template emplace<2>(execution::as_exception_ptr(std::forward<E>(error)));
+        complete();
+    }
+
+    void set_stopped()
+    {
+        _stopped = true;
+        complete();
+    }
+
+private:
+    std::coroutine_handle<> continuation() noexcept
+    {
+        return _stopped
+            ? _promise->unhandled_stopped()
+            : _handle;
+    }
+
+    void complete() noexcept
+    {
+        auto* completion = current_inline_completion;
+
+        if (completion && completion->_awaitable == this) {
+            completion->_completed = true;
+        } else {
+            continuation().resume();
+        }
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+struct promise_result
+    : promise_base
+{
+    using value_t = std::conditional_t<std::is_void_v<T>, std::tuple<>, T>;
+
+    std::variant<std::monostate, value_t, std::exception_ptr> _result;
+
+    void unhandled_exception() noexcept
+    {
+        _result.template emplace<2>(std::current_exception());
+    }
+
+    T result()
+    {
+        if (_result.index() == 2) {
+            std::rethrow_exception(std::get<2>(std::move(_result)));
+        }
+
+        if constexpr (!std::is_void_v<T>) {
+            return std::get<1>(std::move(_result));
+        }
+    }
+};
+
+// a promise can't have both return_value and return_void
+template <typename T>
+struct promise_return
+    : promise_result<T>
+{
+    template <typename U = T>
+    void return_value(U&& value)
+    {
+        this->_result.template emplace<1>(std::forward<U>(value));
+    }
+};
+
+template <>
+struct promise_return<void>
+    : promise_result<void>
+{
+    void return_void() noexcept
+    {
+        _result.template emplace<1>();
+    }
+};
+
+template <typename T>
+struct promise
+    : promise_return<T>
+{
+    task<T> get_return_object(std::coroutine_handle<> coroutine) noexcept;
+
+    template <typename A>
+    decltype(auto) await_transform(A&& obj)
+    {
+        if constexpr (awaitable<A>) {
+            return std::forward<A>(obj);
+        } else {
+            return sender_awaitable<std::decay_t<A>>{
+                std::forward<A>(obj),
+                *this,
+                this->_coroutine
+            };
+        }
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+// the position of the allocator among the parameters of a coroutine: right
+// after a leading std::allocator_arg, or after the object of a member
+// function or lambda. 0 when the coroutine doesn't take an allocator
+template <typename ... Args>
+constexpr std::size_t allocator_position = [] {
+    constexpr bool is_allocator_arg[] = {
+        std::is_same_v<Args, std::allocator_arg_t>...,
+        false,
+        false
+    };
+
+    if (sizeof ... (Args) >= 2 && is_allocator_arg[0]) {
+        return std::size_t{1};
+    }
+    if (sizeof ... (Args) >= 3 && is_allocator_arg[1]) {
+        return std::size_t{2};
+    }
+    return std::size_t{0};
+} ();
+
+// the promise of a coroutine with the parameters Args (see coroutine_traits
+// below). Its operator new and delete aren't templates but members of the
+// same class, so that compilers can tell that they match each other
+template <typename T, typename ... Args>
+struct frame_promise
+    : promise<T>
+{
+    static constexpr std::size_t allocator_index = allocator_position<Args...>;
+
+    task<T> get_return_object() noexcept
+    {
+        return promise<T>::get_return_object(
+            std::coroutine_handle<frame_promise>::from_promise(*this));
+    }
+
+    // frames are allocated with the allocator passed after
+    // std::allocator_arg, otherwise on the heap. Pass a slab_allocator to
+    // recycle them through the thread-local slab cache
+
+    static void* operator new (std::size_t size)
+    {
+        return allocate_frame(size, std::allocator<std::byte>{});
+    }
+
+    static void* operator new (std::size_t size, Args const& ... args)
+        requires (allocator_index != 0)
+    {
+        return allocate_frame(size, std::get<allocator_index>(std::tie(args...)));
+    }
+
+    static void operator delete (void* frame) noexcept
+    {
+        deallocate_frame(frame);
+    }
+
+    // the placement form matching the one of operator new
+    static void operator delete (void* frame, Args const& ...) noexcept
+        requires (allocator_index != 0)
+    {
+        deallocate_frame(frame);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// co_await task
+
+template <typename T>
+struct task_awaiter
+{
+    promise<T>* _promise;
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    template <typename P>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<P> parent) noexcept
+    {
+        promise_base& p = *_promise;
+        promise_base& pp = parent.promise();
+
+        p._continuation = parent;
+        p._stop_token = pp._stop_token;
+        p._parent = &pp;
+        p._unhandled_stopped = [] (void* parent) noexcept {
+            return static_cast<promise_base*>(parent)->unhandled_stopped();
+        };
+
+        // symmetric transfer: start the task without nesting on the stack
+        return p._coroutine;
+    }
+
+    T await_resume()
+    {
+        return _promise->result();
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// connect(task, receiver)
+
+template <typename T, typename R>
+struct operation
+{
+    struct forward_stop_request
+    {
+        inplace_stop_source* _stop_source;
+
+        void operator () () noexcept
+        {
+            _stop_source->request_stop();
+        }
+    };
+
+    using stop_callback_t = stop_callback_for_t<
+        stop_token_of_t<R>,
+        forward_stop_request>;
+
+    promise<T>* _promise;
+    R _receiver;
+
+    inplace_stop_source _stop_source;
+    std::optional<stop_callback_t> _stop_callback;
+
+    template <typename Rx>
+    operation(promise<T>* promise, Rx&& receiver)
+        : _promise{promise}
+        , _receiver(std::forward<Rx>(receiver))
+    {}
+
+    // movable until started
+    operation(operation&& other)
+            noexcept(std::is_nothrow_move_constructible_v<R>)
+        : _promise{std::exchange(other._promise, nullptr)}
+        , _receiver(std::move(other._receiver))
+    {}
+
+    ~operation()
+    {
+        if (_promise) {
+            _promise->_coroutine.destroy();
+        }
+    }
+
+    void start() & noexcept
+    {
+        promise_base& p = *_promise;
+
+        p._parent = this;
+        p._complete = [] (void* self) noexcept {
+            static_cast<operation*>(self)->finish();
+        };
+        p._unhandled_stopped = [] (void* self) noexcept -> std::coroutine_handle<> {
+            static_cast<operation*>(self)->finish_stopped();
+            return std::noop_coroutine();
+        };
+
+        auto token = execution::get_stop_token(_receiver);
+
+        if constexpr (std::is_same_v<stop_token_of_t<R>, inplace_stop_token>) {
+            p._stop_token = std::move(token);
+        } else if (token.stop_possible()) {
+            _stop_callback.emplace(std::move(token), forward_stop_request{&_stop_source});
+            p._stop_token = _stop_source.get_token();
+        }
+
+        p._coroutine.resume();
+    }
+
+private:
+    void finish() noexcept
+    {
+        auto result = std::move(_promise->_result);
+
+        std::exchange(_promise, nullptr)->_coroutine.destroy();
+        _stop_callback.reset();
+
+        if (result.index() == 2) {
+            execution::set_error(
+                std::move(_receiver),
+                std::get<2>(std::move(result)));
+        } else if constexpr (std::is_void_v<T>) {
+            execution::set_value(std::move(_receiver));
+        } else {
+            execution::set_value(
+                std::move(_receiver),
+                std::get<1>(std::move(result)));
+        }
+    }
+
+    void finish_stopped() noexcept
+    {
+        std::exchange(_promise, nullptr)->_coroutine.destroy();
+        _stop_callback.reset();
+
+        execution::set_stopped(std::move(_receiver));
+    }
+};
+
+}   // namespace task_impl
+
+////////////////////////////////////////////////////////////////////////////////
+
+// lazily started coroutine that can co_await senders and is a sender itself.
+// Pass `std::allocator_arg, allocator` as the first parameters of the
+// coroutine to allocate its frame with `allocator` (e.g. a per-request
+// arena); frames are created before the task is connected, so the
+// allocator can't come from the receiver. Nor is it inherited by the tasks
+// the coroutine calls: pass it down to them the same way, or their frames
+// come from the heap.
+template <typename T>
+class [[ nodiscard ]] task
+{
+    friend task_impl::promise<T>;
+
+public:
+    template <typename R>
+    using operation_t = task_impl::operation<T, std::decay_t<R>>;
+
+    using values_t = std::conditional_t<
+        std::is_void_v<T>,
+        meta::list<signature<>>,
+        meta::list<signature<T>>>;
+
+    using errors_t = meta::list<std::exception_ptr>;
+
+private:
+    task_impl::promise<T>* _promise;
+
+    explicit task(task_impl::promise<T>* promise) noexcept
+        : _promise{promise}
+    {}
+
+public:
+    task(task&& other) noexcept
+        : _promise{std::exchange(other._promise, nullptr)}
+    {}
+
+    task& operator = (task&& other) noexcept
+    {
+        if (this != &other) {
+            if (_promise) {
+                _promise->_coroutine.destroy();
+            }
+            _promise = std::exchange(other._promise, nullptr);
+        }
+        return *this;
+    }
+
+    ~task()
+    {
+        if (_promise) {
+            _promise->_coroutine.destroy();
+        }
+    }
+
+    template <typename R>
+    auto connect(R&& receiver) && -> operation_t<R>
+    {
+        return {std::exchange(_promise, nullptr), std::forward<R>(receiver)};
+    }
+
+    auto operator co_await () && noexcept
+    {
+        return task_impl::task_awaiter<T>{_promise};
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace task_impl {
+
+template <typename T>
+task<T> promise<T>::get_return_object(std::coroutine_handle<> coroutine) noexcept
+{
+    this->_coroutine = coroutine;
+    return task<T>{this};
+}
+
+}   // namespace task_impl
+
+}   // namespace execution
+
+// the promise of a coroutine returning a task depends on its parameters,
+// which select the allocator of its frame
+template <typename T, typename ... Args>
+struct std::coroutine_traits<execution::task<T>, Args...>
+{
+    using promise_type = execution::task_impl::frame_promise<
+        T,
+        std::remove_cvref_t<Args>...>;
+};
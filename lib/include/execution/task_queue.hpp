@@ -1,6 +1,12 @@
 #pragma once
 
+#include "metrics.hpp"
+#include "spin_wait.hpp"
+
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
+#include <cstdint>
 #include <mutex>
 #include <queue>
 
@@ -13,39 +19,211 @@ struct task_base
     using execute_t = void (task_base::*)();
 
     execute_t _execute = nullptr;
+    task_base* _next = nullptr;
+
+    [[ no_unique_address ]] task_timestamp _enqueued_at = {};
 };
 
+inline void mark_enqueued(task_base* task) noexcept
+{
+    if constexpr (metrics_enabled) {
+        if (task) {
+            task->_enqueued_at.set(metrics_clock_t::now());
+        }
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
-class task_queue
+// what the task queues have in common: the count of their tasks, the
+// workers parked waiting for one, closing and sealing. A queue pushes its
+// tasks under lock() then calls notify(); a worker that finds the queue
+// empty spins for a while before it parks, and enqueue only notifies when
+// a worker is parked.
+//
+// Once closed, wait returns on an empty queue instead of parking; once
+// sealed, the queue refuses the tasks
+class task_queue_base
 {
 private:
     std::mutex _mtx;
     std::condition_variable _cv;
-    std::queue<task_base*> _tasks;
+
+    // the number of tasks, polled without the lock by spinning workers
+    std::atomic<std::size_t> _size = 0;
+    std::size_t _sleepers = 0;
+
+    bool _closed = false;
+    bool _sealed = false;
+
+    adaptive_spin _spin;
 
 public:
-    void enqueue(task_base* task)
+    explicit task_queue_base(std::uint32_t spin_limit) noexcept
+        : _spin {spin_limit}
+    {}
+
+    std::size_t size() const noexcept
+    {
+        return _size.load(std::memory_order_relaxed);
+    }
+
+    // the parked workers wake up and leave; the queued tasks are still
+    // dequeued first
+    void close()
     {
         std::unique_lock lock {_mtx};
 
-        _tasks.push(task);
-        _cv.notify_one();
+        _closed = true;
+        lock.unlock();
+
+        _cv.notify_all();
     }
 
-    task_base* dequeue()
+    // closes the queue and refuses the tasks from now on; the ones already
+    // queued are left for try_dequeue
+    void seal()
     {
         std::unique_lock lock {_mtx};
-        _cv.wait(lock, [this] {
-            return !_tasks.empty();
+
+        _sealed = true;
+        _closed = true;
+        lock.unlock();
+
+        _cv.notify_all();
+    }
+
+protected:
+    // held while the tasks are pushed, and while they are popped by the
+    // queues that have no lock of their own
+    std::unique_lock<std::mutex> lock()
+    {
+        return std::unique_lock {_mtx};
+    }
+
+    // with the lock held
+    bool sealed() const noexcept
+    {
+        return _sealed;
+    }
+
+    // once `count` tasks are pushed: wakes up to `count` parked workers,
+    // after the lock is released
+    void notify(std::unique_lock<std::mutex>& lock, std::size_t count)
+    {
+        _size.fetch_add(count, std::memory_order_release);
+
+        auto const wake = std::min(count, _sleepers);
+        lock.unlock();
+
+        for (auto n = wake; n; --n) {
+            _cv.notify_one();
+        }
+    }
+
+    // once a task is popped
+    void popped() noexcept
+    {
+        _size.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // returns with the lock held, once there is a task or the queue is
+    // closed
+    std::unique_lock<std::mutex> wait()
+    {
+        _spin.wait([this] {
+            return _size.load(std::memory_order_relaxed) != 0;
         });
 
+        std::unique_lock lock {_mtx};
+
+        if (!_size.load(std::memory_order_relaxed) && !_closed) {
+            ++_sleepers;
+            count_park();
+            _cv.wait(lock, [this] {
+                return _size.load(std::memory_order_relaxed) != 0 || _closed;
+            });
+            --_sleepers;
+        }
+
+        return lock;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+class task_queue
+    : public task_queue_base
+{
+private:
+    std::queue<task_base*> _tasks;
+
+public:
+    explicit task_queue(std::uint32_t spin_limit = adaptive_spin::default_limit) noexcept
+        : task_queue_base {spin_limit}
+    {}
+
+    // false once sealed
+    bool enqueue(task_base* task)
+    {
+        return enqueue_n(task, 1);
+    }
+
+    // the same task `count` times, e.g. the executions of a bulk
+    bool enqueue_n(task_base* task, std::size_t count)
+    {
+        mark_enqueued(task);
+
+        auto lock = task_queue_base::lock();
+
+        if (sealed()) {
+            return false;
+        }
+
+        for (auto n = count; n; --n) {
+            _tasks.push(task);
+        }
+
+        notify(lock, count);
+        return true;
+    }
+
+    // the tasks linked through _next from `first` to `last`, both included
+    bool enqueue_batch(task_base* first, task_base* last)
+    {
+        std::size_t count = 0;
+
+        auto lock = task_queue_base::lock();
+
+        if (sealed()) {
+            return false;
+        }
+
+        for (auto* task = first;; task = task->_next) {
+            mark_enqueued(task);
+            _tasks.push(task);
+            ++count;
+
+            if (task == last) {
+                break;
+            }
+        }
+
+        notify(lock, count);
+        return true;
+    }
+
+    // nullptr once the queue is closed and empty
+    task_base* dequeue()
+    {
+        auto lock = wait();
+
         return try_dequeue_impl();
     }
 
     task_base* try_dequeue()
     {
-        std::unique_lock lock {_mtx};
+        auto lock = task_queue_base::lock();
 
         return try_dequeue_impl();
     }
@@ -59,6 +237,7 @@ private:
 
         task_base* t = _tasks.front();
         _tasks.pop();
+        popped();
         return t;
     }
 };
@@ -66,17 +245,19 @@ private:
 ////////////////////////////////////////////////////////////////////////////////
 
 class priority_task_queue
+    : public task_queue_base
 {
     using queue_t = std::queue<task_base*>;
 
 private:
-    std::mutex _mtx;
-    std::condition_variable _cv;
-
     queue_t _hi;
     queue_t _lo;
 
 public:
+    explicit priority_task_queue(std::uint32_t spin_limit = adaptive_spin::default_limit) noexcept
+        : task_queue_base {spin_limit}
+    {}
+
     void enqueue_hi(task_base* task)
     {
         enqueue(_hi, task);
@@ -87,20 +268,32 @@ public:
         enqueue(_lo, task);
     }
 
-    task_base* dequeue()
+    void enqueue_lo_n(task_base* task, std::size_t count)
     {
-        std::unique_lock lock {_mtx};
+        enqueue_n(_lo, task, count);
+    }
 
-        _cv.wait(lock, [this] {
-            return !_hi.empty() || !_lo.empty();
-        });
+    // see task_queue::enqueue_batch
+    void enqueue_hi_batch(task_base* first, task_base* last)
+    {
+        enqueue_batch(_hi, first, last);
+    }
+
+    void enqueue_lo_batch(task_base* first, task_base* last)
+    {
+        enqueue_batch(_lo, first, last);
+    }
+
+    task_base* dequeue()
+    {
+        auto lock = wait();
 
         return try_dequeue_impl();
     }
 
     task_base* try_dequeue()
     {
-        std::unique_lock lock {_mtx};
+        auto lock = task_queue_base::lock();
 
         return try_dequeue_impl();
     }
@@ -108,10 +301,39 @@ public:
 private:
     void enqueue(queue_t& q, task_base* task)
     {
-        std::unique_lock lock {_mtx};
+        enqueue_n(q, task, 1);
+    }
+
+    void enqueue_n(queue_t& q, task_base* task, std::size_t count)
+    {
+        mark_enqueued(task);
+
+        auto lock = task_queue_base::lock();
+
+        for (auto n = count; n; --n) {
+            q.push(task);
+        }
+
+        notify(lock, count);
+    }
+
+    void enqueue_batch(queue_t& q, task_base* first, task_base* last)
+    {
+        std::size_t count = 0;
+
+        auto lock = task_queue_base::lock();
+
+        for (auto* task = first;; task = task->_next) {
+            mark_enqueued(task);
+            q.push(task);
+            ++count;
+
+            if (task == last) {
+                break;
+            }
+        }
 
-        q.push(task);
-        _cv.notify_one();
+        notify(lock, count);
     }
 
     task_base* try_dequeue_impl()
@@ -126,6 +348,7 @@ private:
 
         auto* t = q->front();
         q->pop();
+        popped();
         return t;
     }
 };
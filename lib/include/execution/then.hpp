@@ -3,6 +3,7 @@
 #include "pipeable.hpp"
 #include "sender_traits.hpp"
 #include "stop_token.hpp"
+#include "trace.hpp"
 
 #include <exception>
 #include <functional>
@@ -24,7 +25,10 @@ struct then_receiver
     {
         execution::set_value_with(
             std::move(_receiver),
-            std::move(_func),
+            execution::trace_call(
+                execution::get_tracer(_receiver),
+                "then",
+                std::move(_func)),
             std::forward<Ts>(values)...
         );
     }
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "spin_wait.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#else
+#include <thread>
+#endif
+
+namespace execution {
+
+////////////////////////////////////////////////////////////////////////////////
+
+enum class sched_policy
+{
+    normal,         // SCHED_OTHER
+    batch,          // SCHED_BATCH
+    idle,           // SCHED_IDLE
+    fifo,           // SCHED_FIFO, real-time
+    round_robin,    // SCHED_RR, real-time
+};
+
+// attributes of a thread created by the library. Only applied on Linux;
+// elsewhere the thread is a plain std::thread
+struct thread_options
+{
+    // truncated to 15 characters
+    std::string name = {};
+
+    // CPUs the thread may run on; empty: inherited from the creator
+    std::vector<int> cpus = {};
+
+    // 0: the default of the platform
+    std::size_t stack_size = 0;
+
+    sched_policy policy = sched_policy::normal;
+
+    // priority of the real-time policies
+    int priority = 0;
+
+    // nice value of the normal policies; empty: inherited
+    std::optional<int> nice = {};
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct thread_pool_options
+{
+    std::size_t worker_count = 1;
+
+    // workers are named "<name>-<index>", <name> truncated so that the
+    // whole fits in 15 characters; empty: not named
+    std::string name = {};
+
+    // CPUs of each worker, reused round robin when there are fewer entries
+    // than workers; empty: not pinned
+    std::vector<std::vector<int>> worker_cpus = {};
+
+    std::size_t stack_size = 0;
+    sched_policy policy = sched_policy::normal;
+    int priority = 0;
+    std::optional<int> nice = {};
+
+    // how long an idle worker may spin before it parks, see adaptive_spin;
+    // 0: parks right away
+    std::uint32_t spin_limit = adaptive_spin::default_limit;
+
+    // called on every worker, on its thread, before it takes any task
+    std::function<void(std::size_t)> on_worker_start = {};
+
+    // the timer thread of timed_thread_pool, the monitor thread of
+    // elastic_thread_pool
+    thread_options dispatcher = {};
+
+    thread_options worker(std::size_t index) const;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+// joinable thread that starts with the given attributes. Throws
+// std::system_error if any of them can't be applied (e.g. a CPU outside
+// of the cgroup, or a real-time policy without CAP_SYS_NICE); the thread
+// function doesn't run in that case
+class worker_thread
+{
+private:
+#if defined(__linux__)
+    pthread_t _handle {};
+    bool _joinable = false;
+#else
+    std::thread _thread;
+#endif
+
+public:
+    worker_thread() noexcept = default;
+    worker_thread(thread_options const& options, std::function<void()> func);
+
+    worker_thread(worker_thread&& other) noexcept;
+    worker_thread& operator = (worker_thread&& other) noexcept;
+
+    ~worker_thread();
+
+    bool joinable() const noexcept;
+    void join();
+};
+
+}   // namespace execution
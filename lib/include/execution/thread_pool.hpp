@@ -1,32 +1,132 @@
 #pragma once
 
+#include "sender_traits.hpp"
 #include "task_queue.hpp"
 #include "thread_pool_impl.hpp"
 #include "thread_pool_scheduler.hpp"
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <utility>
 
 namespace execution {
 
+class thread_pool;
+
+namespace thread_pool_join_impl {
+
 ////////////////////////////////////////////////////////////////////////////////
 
+template <typename R>
+struct operation
+    : task_base
+{
+    thread_pool* _pool;
+    R _receiver;
+
+    template <typename U>
+    operation(thread_pool* pool, U&& receiver)
+        : task_base {
+            ._execute = static_cast<task_base::execute_t>(&operation::execute)
+        }
+        , _pool {pool}
+        , _receiver {std::forward<U>(receiver)}
+    {}
+
+    void start() &;
+
+    void execute()
+    {
+        execution::set_value(std::move(_receiver));
+    }
+};
+
+struct sender
+{
+    thread_pool* _pool;
+
+    template <typename R>
+    auto connect(R&& receiver) const
+    {
+        return operation<std::decay_t<R>>{_pool, std::forward<R>(receiver)};
+    }
+};
+
+}   // namespace thread_pool_join_impl
+
+template <typename R>
+struct sender_traits<thread_pool_join_impl::sender, R>
+{
+    using operation_t = thread_pool_join_impl::operation<std::decay_t<R>>;
+    using values_t = meta::list<signature<>>;
+    using errors_t = meta::list<>;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+// stops in one of three ways:
+// - stop(): runs everything that is queued, then joins the workers
+// - request_stop(): completes the queued operations with set_stopped
+//   without waiting for them
+// - stop(deadline): stop() until the deadline, then request_stop()
+//
+// A task scheduled after the workers have left runs on the calling thread
+// (an operation completes with set_stopped after request_stop). join()
+// tells when the workers are done
 class thread_pool
     : thread_pool_impl<thread_pool>
 {
     friend thread_pool_impl;
 
+    template <typename R>
+    friend struct thread_pool_join_impl::operation;
+
 private:
     task_queue _queue;
-    std::atomic_flag _should_stop = {};
+    std::atomic<bool> _stop_requested = false;
+    std::once_flag _joined;
+
+    std::mutex _exit_mtx;
+    std::condition_variable _exit_cv;
+    std::size_t _running = 0;
+    bool _drained = false;
+
+    // the operations of join(), linked through _next
+    task_base* _joiners = nullptr;
 
 public:
     explicit thread_pool(std::size_t worker_count);
+    explicit thread_pool(thread_pool_options options);
     ~thread_pool();
 
     void stop();
+    void stop(std::chrono::steady_clock::time_point deadline);
+    void request_stop();
+
+    bool stop_requested() const noexcept
+    {
+        return _stop_requested.load(std::memory_order_acquire);
+    }
+
+    // completes once the pool stopped and the workers ran their last task,
+    // on the last of them: the pool must not be destroyed from there
+    thread_pool_join_impl::sender join() noexcept
+    {
+        return {this};
+    }
 
     void schedule(task_base* task);
 
+    // under one lock, waking at most as many workers as there are tasks;
+    // see task_queue::enqueue_n and task_queue::enqueue_batch
+    void schedule_n(task_base* task, std::size_t count);
+    void schedule_batch(task_base* first, task_base* last);
+
+    using thread_pool_impl::metrics;
+    using thread_pool_impl::options;
+
     thread_pool_scheduler<thread_pool> get_scheduler()
     {
         return {this};
@@ -37,6 +137,18 @@ private:
     {
         return _queue;
     }
+
+    void exit_worker(std::size_t index);
+    void add_joiner(task_base* task);
+    void join_workers();
 };
 
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename R>
+void thread_pool_join_impl::operation<R>::start() &
+{
+    _pool->add_joiner(this);
+}
+
 }   // namespace execution
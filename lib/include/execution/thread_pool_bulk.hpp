@@ -2,10 +2,12 @@
 
 #include "bulk.hpp"
 #include "sender_traits.hpp"
+#include "stop_token.hpp"
 #include "task_queue.hpp"
 #include "tuple.hpp"
 #include "variant.hpp"
 
+#include <atomic>
 #include <exception>
 #include <functional>
 
@@ -47,6 +49,38 @@ struct source_receiver
 
 ////////////////////////////////////////////////////////////////////////////////
 
+// how the `shape` executions of a bulk are queued to the pool and which
+// index each of them runs; pools can specialize it to keep index ranges
+// on particular workers
+template <typename P, typename I>
+struct bulk_dispatch
+{
+    std::atomic<I> _index = {};
+
+    bulk_dispatch(P*, I)
+    {}
+
+    // `task` may be completed and destroyed by the time the last call to
+    // schedule returns
+    static void schedule(P* pool, task_base* task, I shape)
+    {
+        if constexpr (requires { pool->schedule_n(task, std::size_t{}); }) {
+            pool->schedule_n(task, static_cast<std::size_t>(shape));
+        } else {
+            for (I i = {}; i != shape; ++i) {
+                pool->schedule(task);
+            }
+        }
+    }
+
+    I next(P*)
+    {
+        return _index.fetch_add(1);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
 template <typename P, typename R, typename S, typename I, typename F>
 struct operation
     : task_base
@@ -78,18 +112,23 @@ struct operation
         }
     };
 
+    using stop_callback_t = stop_callback_for_t<
+        stop_token_of_t<R>,
+        cancel_callback>;
+
     struct bulk_state
     {
         std::atomic_flag _error_or_stopped = {};
         std::atomic<I> _active_ops = {};
-        std::atomic<I> _index = {};
+        bulk_dispatch<P, I> _dispatch;
 
         std::exception_ptr _error;
 
-        std::stop_callback<cancel_callback> _stop_callback;
+        stop_callback_t _stop_callback;
 
-        bulk_state(I shape, auto token)
+        bulk_state(P* pool, I shape, auto token)
             : _active_ops {shape}
+            , _dispatch {pool, shape}
             , _stop_callback {
                 token,
                 cancel_callback{&_error_or_stopped}
@@ -145,9 +184,14 @@ struct operation
     {
         auto& state = std::get<bulk_state>(_state);
 
+        // the chunks left in the queue are skipped, see thread_pool::request_stop
+        if (stop_requested()) {
+            state._error_or_stopped.test_and_set();
+        }
+
         try {
             if (!state._error_or_stopped.test()) {
-                const I i = state._index.fetch_add(1);
+                const I i = state._dispatch.next(_pool);
 
                 std::apply(
                     [this, i] (auto&& ... values) {
@@ -168,6 +212,17 @@ struct operation
         }
     }
 
+    bool stop_requested() const noexcept
+    {
+        if constexpr (requires { _pool->stop_requested(); }) {
+            if (_pool->stop_requested()) {
+                return true;
+            }
+        }
+
+        return execution::get_stop_token(_receiver).stop_requested();
+    }
+
     template <typename T>
     void finish(bulk_state& state)
     {
@@ -195,15 +250,14 @@ struct operation
         _storage.template emplace<tuple_t>(std::forward<Ts>(values)...);
 
         auto& state = _state.template emplace<bulk_state>(
+            _pool,
             _shape,
             execution::get_stop_token(_receiver));
 
         this->_execute = static_cast<task_base::execute_t>(
             &operation::execute<tuple_t>);
 
-        for (I i = {}; i != _shape; ++i) {
-            _pool->schedule(this);
-        }
+        state._dispatch.schedule(_pool, this, _shape);
     }
 
     template <typename E>
@@ -1,8 +1,13 @@
 #pragma once
 
+#include "metrics.hpp"
+#include "task_queue.hpp"
+#include "thread_options.hpp"
+
 #include <atomic>
 #include <functional>
-#include <thread>
+#include <memory>
+#include <utility>
 #include <vector>
 
 namespace execution {
@@ -13,20 +18,34 @@ template <typename Derived>
 class thread_pool_impl
 {
 private:
-    std::vector<std::thread> _threads;
+    thread_pool_options _options;
+    std::vector<worker_thread> _threads;
+    std::unique_ptr<worker_metrics[]> _metrics;
 
 public:
-    explicit thread_pool_impl(std::size_t worker_count)
+    explicit thread_pool_impl(thread_pool_options options)
+        : _options {std::move(options)}
     {
-        _threads.reserve(worker_count);
+        _threads.reserve(_options.worker_count);
+
+        if constexpr (metrics_enabled) {
+            _metrics = std::make_unique<worker_metrics[]>(_options.worker_count);
+        }
     }
 
+    // throws std::system_error if a worker can't be started with its
+    // options; the workers started so far are stopped first
     void start()
     {
-        for (std::size_t n = _threads.capacity(); n; --n) {
-            _threads.emplace_back([this] {
-                worker();
-            });
+        try {
+            for (std::size_t i = 0; i != _options.worker_count; ++i) {
+                _threads.emplace_back(_options.worker(i), [this, i] {
+                    worker(i);
+                });
+            }
+        } catch (...) {
+            static_cast<Derived*>(this)->stop();
+            throw;
         }
     }
 
@@ -42,10 +61,47 @@ public:
         }
     }
 
+    thread_pool_options const& options() const noexcept
+    {
+        return _options;
+    }
+
+    // empty unless built with EXECUTION_ENABLE_METRICS
+    pool_metrics_snapshot metrics()
+    {
+        pool_metrics_snapshot s;
+
+        if constexpr (metrics_enabled) {
+            s.workers.reserve(_options.worker_count);
+            for (std::size_t i = 0; i != _options.worker_count; ++i) {
+                s.workers.push_back(_metrics[i].snapshot());
+            }
+
+            s.queue_depth = static_cast<Derived*>(this)->get_queue().size();
+        }
+
+        return s;
+    }
+
 private:
-    void worker()
+    void worker(std::size_t index)
     {
-        auto& queue = static_cast<Derived*>(this)->get_queue();
+        auto& self = *static_cast<Derived*>(this);
+
+        // per-thread setup of the pool (affinity, thread-local state)
+        if constexpr (requires { self.init_worker(index); }) {
+            self.init_worker(index);
+        }
+
+        if (_options.on_worker_start) {
+            _options.on_worker_start(index);
+        }
+
+        if constexpr (metrics_enabled) {
+            current_worker_metrics = &_metrics[index];
+        }
+
+        auto& queue = self.get_queue();
 
         for (;;) {
             auto* task = queue.dequeue();
@@ -53,9 +109,32 @@ private:
                 break;
             }
 
-            std::invoke(task->_execute, task);
+            if constexpr (metrics_enabled) {
+                execute(task, _metrics[index]);
+            } else {
+                std::invoke(task->_execute, task);
+            }
+        }
+
+        if constexpr (metrics_enabled) {
+            current_worker_metrics = nullptr;
+        }
+
+        if constexpr (requires { self.exit_worker(index); }) {
+            self.exit_worker(index);
         }
     }
+
+    static void execute(task_base* task, worker_metrics& metrics)
+    {
+        auto const started = metrics_clock_t::now();
+        metrics._queue_wait.record(started - task->_enqueued_at.get());
+
+        std::invoke(task->_execute, task);
+
+        metrics._run_time.record(metrics_clock_t::now() - started);
+        metrics._tasks.fetch_add(1, std::memory_order_relaxed);
+    }
 };
 
 }   // namespace execution
@@ -3,6 +3,7 @@
 #include "sender_traits.hpp"
 #include "stop_token.hpp"
 #include "task_queue.hpp"
+#include "trace.hpp"
 #include "thread_pool_bulk.hpp"
 
 #include <functional>
@@ -14,6 +15,37 @@ namespace thread_pool_scheduler_impl {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+template <typename T>
+struct schedule_on
+{
+    T* _pool;
+
+    void operator () (task_base* task) const
+    {
+        _pool->schedule(task);
+    }
+
+    // a pool that completes its queued operations with set_stopped once
+    // asked to stop, see thread_pool::request_stop
+    bool stop_requested() const noexcept
+        requires requires (T const& pool) { pool.stop_requested(); }
+    {
+        return _pool->stop_requested();
+    }
+};
+
+template <typename F>
+bool pool_stop_requested(F const& func) noexcept
+{
+    if constexpr (requires { func.stop_requested(); }) {
+        return func.stop_requested();
+    } else {
+        return false;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 template <typename F, typename R>
 struct operation
     : task_base
@@ -32,12 +64,18 @@ struct operation
 
     void start() &
     {
+        execution::get_tracer(_receiver).flow_begin("schedule", this);
         std::invoke(_func, this);
     }
 
     void execute()
     {
-        if (execution::get_stop_token(_receiver).stop_requested()) {
+        auto const tracer = execution::get_tracer(_receiver);
+
+        trace_scope scope {tracer, "execute"};
+        tracer.flow_end("schedule", this);
+
+        if (execution::get_stop_token(_receiver).stop_requested() || pool_stop_requested(_func)) {
             execution::set_stopped(std::move(_receiver));
         } else {
             execution::set_value(std::move(_receiver));
@@ -59,7 +97,7 @@ struct sender
     auto connect(R&& receiver) const
     {
         return operation {
-            [pool = _pool] (auto* task) { pool->schedule(task); },
+            schedule_on<T>{_pool},
             std::forward<R>(receiver)
         };
     }
@@ -46,15 +46,22 @@ private:
     std::mutex _mtx;
     std::condition_variable _cv;
     scheduled_tasks_t _scheduled_tasks;
-    std::thread _dispatcher;
 
     std::atomic_flag _should_stop = {};
 
+    [[ no_unique_address ]] metrics_histogram _timer_lateness;
+
+    worker_thread _dispatcher;
+
 public:
     explicit timed_thread_pool(std::size_t worker_count);
+    explicit timed_thread_pool(thread_pool_options options);
     ~timed_thread_pool();
 
     void schedule(task_base* task);
+    void schedule_n(task_base* task, std::size_t count);
+    void schedule_batch(task_base* first, task_base* last);
+
     void schedule_at(time_point_t deadline, task_base* task);
 
     template <typename D>
@@ -65,6 +72,10 @@ public:
 
     void stop();
 
+    pool_metrics_snapshot metrics();
+
+    using thread_pool_impl::options;
+
     thread_pool_scheduler<timed_thread_pool> get_scheduler()
     {
         return {this};
@@ -0,0 +1,208 @@
+#pragma once
+
+#include "customization.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace execution {
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct trace_event
+{
+    char const* _name = nullptr;
+    std::uint64_t _id = 0;
+    std::uint64_t _timestamp = 0;   // ns since the log was created
+    std::uint32_t _tid = 0;
+    char _phase = 0;                // chrome trace phase: B, E, b, e, s, f
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+// collects trace events into per-thread ring buffers: each thread writes only
+// to its own buffer so recording doesn't take any locks (a mutex is taken
+// once per thread, to register its buffer). The events of a thread whose
+// buffer can't be allocated are dropped. Dump the log when the traced work
+// has completed.
+class trace_log
+{
+private:
+    struct ring
+    {
+        std::thread::id _thread;
+        std::uint32_t _tid;
+        std::unique_ptr<trace_event[]> _events;
+        std::atomic<std::uint64_t> _head = 0;
+    };
+
+    using clock_t = std::chrono::steady_clock;
+
+    std::uint64_t const _log_id;
+    std::size_t const _capacity;
+    clock_t::time_point const _epoch;
+
+    std::mutex _mtx;
+    std::vector<std::unique_ptr<ring>> _rings;
+
+public:
+    explicit trace_log(std::size_t capacity_per_thread = 1 << 14);
+
+    trace_log(trace_log const&) = delete;
+    trace_log& operator = (trace_log const&) = delete;
+
+    void emit(char phase, char const* name, std::uint64_t id = 0) noexcept;
+
+    // events of all threads ordered by time
+    std::vector<trace_event> events();
+
+    // Chrome trace event format, loadable by chrome://tracing and Perfetto
+    void write_chrome_json(std::ostream& os);
+
+private:
+    ring* local_ring() noexcept;
+    ring* register_thread() noexcept;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+// tracer of receivers that didn't ask for tracing: every call is a no-op
+struct null_tracer
+{
+    static constexpr bool enabled = false;
+
+    void begin(char const*) const noexcept {}
+    void end(char const*) const noexcept {}
+    void async_begin(char const*, void const*) const noexcept {}
+    void async_end(char const*, void const*) const noexcept {}
+    void flow_begin(char const*, void const*) const noexcept {}
+    void flow_end(char const*, void const*) const noexcept {}
+};
+
+class tracer
+{
+private:
+    trace_log* _log;
+
+public:
+    static constexpr bool enabled = true;
+
+    explicit tracer(trace_log& log) noexcept
+        : _log{&log}
+    {}
+
+    // synchronous slice on the calling thread
+    void begin(char const* name) const noexcept
+    {
+        _log->emit('B', name);
+    }
+
+    void end(char const* name) const noexcept
+    {
+        _log->emit('E', name);
+    }
+
+    // span that may start and end on different threads, e.g. an operation
+    void async_begin(char const* name, void const* id) const noexcept
+    {
+        _log->emit('b', name, to_id(id));
+    }
+
+    void async_end(char const* name, void const* id) const noexcept
+    {
+        _log->emit('e', name, to_id(id));
+    }
+
+    // arrow from the thread that scheduled work to the one that runs it
+    void flow_begin(char const* name, void const* id) const noexcept
+    {
+        _log->emit('s', name, to_id(id));
+    }
+
+    void flow_end(char const* name, void const* id) const noexcept
+    {
+        _log->emit('f', name, to_id(id));
+    }
+
+private:
+    static std::uint64_t to_id(void const* id) noexcept
+    {
+        return reinterpret_cast<std::uintptr_t>(id);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline constexpr struct get_tracer_fn
+{
+    // default implementation
+    template <typename R>
+        requires (!is_tag_invocable_v<get_tracer_fn, R const&>)
+    auto operator () (R const&) const noexcept
+    {
+        return null_tracer{};
+    }
+
+    template <typename R>
+        requires is_tag_invocable_v<get_tracer_fn, R const&>
+    auto operator () (R const& obj) const noexcept
+        -> tag_invoke_result_t<get_tracer_fn, R const&>
+    {
+        return execution::tag_invoke(*this, obj);
+    }
+
+} get_tracer;
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+class trace_scope
+{
+private:
+    T _tracer;
+    char const* _name;
+
+public:
+    trace_scope(T tracer, char const* name) noexcept
+        : _tracer{tracer}
+        , _name{name}
+    {
+        _tracer.begin(_name);
+    }
+
+    trace_scope(trace_scope const&) = delete;
+    trace_scope& operator = (trace_scope const&) = delete;
+
+    ~trace_scope()
+    {
+        _tracer.end(_name);
+    }
+};
+
+// wraps a user function so that its invocations show up as slices named
+// `name`; returns the function itself when tracing is disabled
+template <typename T, typename F>
+decltype(auto) trace_call(T tracer, char const* name, F&& func)
+{
+    if constexpr (!T::enabled) {
+        return std::forward<F>(func);
+    } else {
+        return [tracer, name, &func] (auto&& ... args) -> decltype(auto) {
+            trace_scope scope {tracer, name};
+            return std::invoke(
+                std::forward<F>(func),
+                std::forward<decltype(args)>(args)...);
+        };
+    }
+}
+
+}   // namespace execution
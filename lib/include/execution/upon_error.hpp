@@ -3,6 +3,7 @@
 #include "pipeable.hpp"
 #include "sender_traits.hpp"
 #include "stop_token.hpp"
+#include "trace.hpp"
 
 #include <exception>
 #include <functional>
@@ -33,7 +34,10 @@ struct upon_error_receiver
     {
         execution::set_value_with(
             std::move(_receiver),
-            std::move(_func),
+            execution::trace_call(
+                execution::get_tracer(_receiver),
+                "upon_error",
+                std::move(_func)),
             std::forward<E>(error)
         );
     }
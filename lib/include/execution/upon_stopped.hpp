@@ -3,6 +3,7 @@
 #include "pipeable.hpp"
 #include "sender_traits.hpp"
 #include "stop_token.hpp"
+#include "trace.hpp"
 
 #include <exception>
 #include <functional>
@@ -38,7 +39,12 @@ struct upon_stopped_receiver
 
     void set_stopped()
     {
-        execution::set_value_with(std::move(_receiver), std::move(_func));
+        execution::set_value_with(
+            std::move(_receiver),
+            execution::trace_call(
+                execution::get_tracer(_receiver),
+                "upon_stopped",
+                std::move(_func)));
     }
 
     template <typename Tag, typename ... Ts>
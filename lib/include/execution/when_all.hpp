@@ -1,5 +1,6 @@
 #pragma once
 
+#include "inplace_stop_token.hpp"
 #include "sender_traits.hpp"
 #include "stop_token.hpp"
 #include "tuple.hpp"
@@ -42,6 +43,73 @@ constexpr auto when_all_values(auto sender_types, auto receiver_types)
 
 ////////////////////////////////////////////////////////////////////////////////
 
+// a sender is no longer needed once it is connected, so it shares
+// the storage with its operation state
+template <typename S, typename O>
+class child
+{
+    enum class state : unsigned char
+    {
+        empty,
+        sender,
+        operation
+    };
+
+private:
+    union
+    {
+        S _sender;
+        O _operation;
+    };
+
+    state _state = state::empty;
+
+public:
+    template <typename U>
+    explicit child(U&& sender)
+        : _sender(std::forward<U>(sender))
+        , _state{state::sender}
+    {}
+
+    child(child const&) = delete;
+    child& operator = (child const&) = delete;
+
+    ~child()
+    {
+        switch (_state) {
+            case state::sender:
+                _sender.~S();
+                break;
+            case state::operation:
+                _operation.~O();
+                break;
+            case state::empty:
+                break;
+        }
+    }
+
+    template <typename R>
+    void connect(R&& receiver)
+    {
+        S sender {std::move(_sender)};
+
+        _sender.~S();
+        _state = state::empty;
+
+        ::new (static_cast<void*>(&_operation)) O(
+            execution::connect(std::move(sender), std::forward<R>(receiver)));
+
+        _state = state::operation;
+    }
+
+    O& get_operation() noexcept
+    {
+        return _operation;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
 template <int I, typename R, typename ... Ts>
 struct receiver
 {
@@ -69,6 +137,7 @@ struct receiver
     // tag_invoke
 
     friend auto tag_invoke(tag_t<get_stop_token>, const self_t& self) noexcept
+        -> inplace_stop_token
     {
         return self._operation->get_stop_token();
     }
@@ -118,18 +187,24 @@ struct operation
         receiver_types);
 
     template <typename ... Us>
-    static constexpr auto as_tuple(meta::atom<signature<Us...>>)
+    static constexpr auto as_optional_tuple(meta::atom<signature<Us...>>)
     {
-        return meta::list<std::tuple<Us...>>{};
+        return meta::atom<std::optional<std::tuple<Us...>>>{};
     }
 
-    static constexpr auto senders_storage_types =
+    static constexpr auto children_types =
+        meta::zip_transform(sender_types, operation_types,
+            [] <typename S, typename O> (meta::atom<S>, meta::atom<O>) {
+                return meta::atom<child<S, O>>{};
+            });
+
+    static constexpr auto values_storage_types =
         meta::zip_transform(sender_types, receiver_types, [] (auto s, auto r) {
-            constexpr auto ls = s | as_tuple(traits::sender_values(s, r).head);
-            return meta::atom<variant_t<decltype(ls)>>{};
+            return as_optional_tuple(traits::sender_values(s, r).head);
         });
 
-    using storage_t = tuple_t<decltype(senders_storage_types)>;
+    using children_t = tuple_t<decltype(children_types)>;
+    using values_storage_t = tuple_t<decltype(values_storage_types)>;
 
     struct cancel_callback
     {
@@ -141,34 +216,34 @@ struct operation
         }
     };
 
-    struct operations
-    {
-        tuple_t<decltype(operation_types)> _operations;
-        std::atomic<int> _active_ops = operation_types.size;
-
-        std::stop_source _stop_source;
-        std::stop_callback<cancel_callback> _stop_callback;
-
-        operations(auto&& token, cancel_callback cb, auto&& ... ops)
-            : _operations{std::move(ops)...}
-            , _stop_callback{std::move(token), cb}
-        {}
-    };
-
-    using state_t = std::variant<std::monostate, operations>;
+    using stop_callback_t = stop_callback_for_t<
+        stop_token_of_t<R>,
+        cancel_callback>;
 
     R _receiver;
 
-    state_t _state;
-    storage_t _storage;
+    inplace_stop_source _stop_source;
+    std::optional<stop_callback_t> _stop_callback;
 
+    std::atomic<int> _active_ops = operation_types.size;
     std::atomic_flag _error_or_stopped = {};
     std::optional<variant_t<decltype(error_types)>> _error;
 
+    values_storage_t _values;
+    children_t _children;
+
     template <typename Rx, typename S>
     operation(Rx&& receiver, S&& senders)
+        : operation(
+            std::forward<Rx>(receiver),
+            std::forward<S>(senders),
+            std::make_index_sequence<sender_types.size>{})
+    {}
+
+    template <typename Rx, typename S, std::size_t ... Is>
+    operation(Rx&& receiver, S&& senders, std::index_sequence<Is...>)
         : _receiver(std::forward<Rx>(receiver))
-        , _storage(std::forward<S>(senders))
+        , _children(std::get<Is>(std::forward<S>(senders))...)
     {}
 
     void start() &
@@ -179,23 +254,20 @@ struct operation
     template <std::size_t ... Is>
     void start_impl(std::index_sequence<Is...>)
     {
-        auto& ops = _state.template emplace<operations>(
-            execution::get_stop_token(_receiver),
-            cancel_callback{this},
-            execution::connect(
-                std::get<0>(std::get<Is>(std::move(_storage))),
-                receiver_t<Is>{this})...
-        );
-
-        (execution::start(std::get<Is>(ops._operations)), ...);
+        auto token = execution::get_stop_token(_receiver);
+        if (token.stop_possible()) {
+            _stop_callback.emplace(std::move(token), cancel_callback{this});
+        }
+
+        (std::get<Is>(_children).connect(receiver_t<Is>{this}), ...);
+
+        (execution::start(std::get<Is>(_children).get_operation()), ...);
     }
 
     template <int i, typename ... Us>
     void set_value(meta::index_t<i>, Us&& ... values)
     {
-        using tuple_t = decayed_tuple_t<Us...>;
-
-        std::get<i>(_storage).template emplace<tuple_t>(std::forward<Us>(values)...);
+        std::get<i>(_values).emplace(std::forward<Us>(values)...);
 
         notify_operation_complete();
     }
@@ -223,12 +295,12 @@ struct operation
 
     void cancel()
     {
-       get_operations()._stop_source.request_stop();
+        _stop_source.request_stop();
     }
 
     void notify_operation_complete()
     {
-        if (get_operations()._active_ops.fetch_sub(1) == 1) {
+        if (_active_ops.fetch_sub(1) == 1) {
             finish();
         }
     }
@@ -236,7 +308,7 @@ struct operation
     void finish() noexcept
     {
         // reset callback
-        _state = std::monostate{};
+        _stop_callback.reset();
 
         if (_error_or_stopped.test()) {
             if (_error) {
@@ -245,22 +317,22 @@ struct operation
                 }, std::move(*_error));
                 return;
             }
-            
+
             execution::set_stopped(std::move(_receiver));
             return;
         }
 
         try {
-            std::apply([this] (auto&&... tuples) {
-                std::apply([this] (auto&& ... values) {
+            std::apply([this] (auto&&... values) {
+                std::apply([this] (auto&& ... vs) {
                         execution::set_value(
                             std::move(_receiver),
-                            std::move(values)...
+                            std::move(vs)...
                         );
                     },
-                    std::tuple_cat(std::get<1>(std::move(tuples))...)
+                    std::tuple_cat(*std::move(values)...)
                 );
-            }, std::move(_storage));
+            }, std::move(_values));
         } catch(...) {
             execution::set_error(std::move(_receiver), std::current_exception());
         }
@@ -271,14 +343,9 @@ struct operation
         return _receiver;
     }
 
-    operations& get_operations()
-    {
-        return std::get<1>(_state);
-    }
-
     auto get_stop_token() const noexcept
     {
-        return std::get<1>(_state)._stop_source.get_token();
+        return _stop_source.get_token();
     }
 };
 
@@ -0,0 +1,443 @@
+#pragma once
+
+#include "get_allocator.hpp"
+#include "inplace_stop_token.hpp"
+#include "sender_traits.hpp"
+#include "stop_token.hpp"
+#include "tuple.hpp"
+#include "variant.hpp"
+
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <vector>
+
+namespace execution {
+namespace when_all_range_impl {
+
+template <typename R, typename T, typename O>
+struct operation;
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct to_vector
+{};
+
+template <typename T>
+using sender_t = std::ranges::range_value_t<T>;
+
+// (S, R) -> std::tuple<> | T | std::tuple<Ts...>
+constexpr auto when_all_range_result(auto sender_type, auto receiver_type)
+{
+    constexpr auto values = traits::sender_values(sender_type, receiver_type);
+
+    static_assert(values.size == 1);
+
+    constexpr auto as_result = [] <typename ... Ts> (meta::atom<signature<Ts...>>) {
+        if constexpr (sizeof ... (Ts) == 1) {
+            return meta::atom<std::decay_t<Ts>...>{};
+        } else {
+            return meta::atom<decayed_tuple_t<Ts...>>{};
+        }
+    };
+
+    return as_result(values.head);
+}
+
+constexpr bool is_void_result(auto sender_type, auto receiver_type)
+{
+    return traits::sender_values(sender_type, receiver_type)
+        == meta::list<signature<>>{};
+}
+
+template <typename O>
+constexpr auto when_all_range_values(auto sender_type, auto receiver_type)
+{
+    if constexpr (!std::is_same_v<O, to_vector>) {
+        return meta::list<signature<O>>{};
+    } else if constexpr (is_void_result(sender_type, receiver_type)) {
+        return meta::list<signature<>>{};
+    } else {
+        using result_t = typename decltype(
+            when_all_range_result(sender_type, receiver_type))::type;
+
+        return meta::list<signature<std::vector<result_t>>>{};
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename R, typename T, typename O>
+struct receiver
+{
+    using self_t = receiver<R, T, O>;
+
+    operation<R, T, O>* _operation;
+    std::size_t _index;
+
+    template <typename ... Us>
+    void set_value(Us&& ... values)
+    {
+        _operation->set_value(_index, std::forward<Us>(values)...);
+    }
+
+    template <typename E>
+    void set_error(E&& error)
+    {
+        _operation->set_error(std::forward<E>(error));
+    }
+
+    void set_stopped()
+    {
+        _operation->set_stopped();
+    }
+
+    // tag_invoke
+
+    friend auto tag_invoke(tag_t<get_stop_token>, const self_t& self) noexcept
+        -> inplace_stop_token
+    {
+        return self._operation->get_stop_token();
+    }
+
+    template <typename Tag, typename ... Us>
+    friend auto tag_invoke(Tag tag, const self_t& self, Us&& ... args)
+        noexcept(is_nothrow_tag_invocable_v<Tag, R, Us...>)
+        -> tag_invoke_result_t<Tag, R, Us...>
+    {
+        return tag(self._operation->get_receiver(), std::forward<Us>(args)...);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename R, typename T, typename O>
+struct operation
+{
+    using receiver_t = receiver<R, T, O>;
+    using child_sender_t = sender_t<T>;
+
+    static constexpr auto sender_type = meta::atom<child_sender_t>{};
+    static constexpr auto receiver_type = meta::atom<receiver_t>{};
+
+    using child_operation_t = typename decltype(
+        traits::sender_operation(sender_type, receiver_type))::type;
+
+    using result_t = typename decltype(
+        when_all_range_result(sender_type, receiver_type))::type;
+
+    static constexpr bool is_void = is_void_result(sender_type, receiver_type);
+
+    static_assert(!is_void || std::is_same_v<O, to_vector>,
+        "when_all_range: can't write void results to an output iterator");
+
+    static constexpr auto error_types = meta::concat_unique(
+        traits::sender_errors(sender_type, receiver_type),
+        meta::list<std::exception_ptr>{}
+    );
+
+    // all the per-sender state lives in one contiguous allocation
+    struct child
+    {
+        child_operation_t _operation;
+        std::optional<result_t> _result;
+
+        template <typename S>
+        child(S&& sender, receiver_t receiver)
+            : _operation(execution::connect(std::forward<S>(sender), std::move(receiver)))
+        {}
+    };
+
+    struct cancel_callback
+    {
+        operation* _operation;
+
+        void operator ()() noexcept
+        {
+            _operation->cancel();
+        }
+    };
+
+    using stop_callback_t = stop_callback_for_t<
+        stop_token_of_t<R>,
+        cancel_callback>;
+
+    using allocator_t = rebind_allocator_t<allocator_of_t<R>, child>;
+
+    R _receiver;
+    T _senders;
+    O _output;
+
+    // taken at connect: the receiver is moved out on completion
+    [[ no_unique_address ]] allocator_t _allocator;
+
+    inplace_stop_source _stop_source;
+    std::optional<stop_callback_t> _stop_callback;
+
+    child* _children = nullptr;
+    std::size_t _size = 0;
+    std::atomic<std::size_t> _active_ops = 0;
+
+    std::atomic_flag _error_or_stopped = {};
+    std::optional<variant_t<decltype(error_types)>> _error;
+
+    template <typename Rx, typename Tx, typename Ox>
+    operation(Rx&& receiver, Tx&& senders, Ox&& output)
+        : _receiver(std::forward<Rx>(receiver))
+        , _senders(std::forward<Tx>(senders))
+        , _output(std::forward<Ox>(output))
+        , _allocator(execution::get_allocator(_receiver))
+    {}
+
+    ~operation()
+    {
+        if (_children) {
+            std::destroy_n(_children, _size);
+            _allocator.deallocate(_children, _size);
+        }
+    }
+
+    void start() & noexcept
+    {
+        try {
+            connect_children();
+        } catch (...) {
+            execution::set_error(std::move(_receiver), std::current_exception());
+            return;
+        }
+
+        auto token = execution::get_stop_token(_receiver);
+        if (token.stop_possible()) {
+            _stop_callback.emplace(std::move(token), cancel_callback{this});
+        }
+
+        // keep one extra reference so that completion can't happen
+        // until every child has been started
+        _active_ops.store(_size + 1);
+
+        for (std::size_t i = 0; i != _size; ++i) {
+            execution::start(_children[i]._operation);
+        }
+
+        notify_operation_complete();
+    }
+
+    template <typename ... Us>
+    void set_value(std::size_t index, Us&& ... values)
+    {
+        if constexpr (!is_void) {
+            _children[index]._result.emplace(std::forward<Us>(values)...);
+        }
+
+        notify_operation_complete();
+    }
+
+    template <typename E>
+    void set_error(E&& error)
+    {
+        if (!_error_or_stopped.test_and_set()) {
+            _error = std::forward<E>(error);
+
+            cancel();
+        }
+
+        notify_operation_complete();
+    }
+
+    void set_stopped()
+    {
+        if (!_error_or_stopped.test_and_set()) {
+            cancel();
+        }
+
+        notify_operation_complete();
+    }
+
+    void cancel()
+    {
+        _stop_source.request_stop();
+    }
+
+    void notify_operation_complete()
+    {
+        if (_active_ops.fetch_sub(1) == 1) {
+            finish();
+        }
+    }
+
+    void finish() noexcept
+    {
+        // reset callback
+        _stop_callback.reset();
+
+        if (_error_or_stopped.test()) {
+            if (_error) {
+                std::visit([this] (auto&& error) {
+                    execution::set_error(std::move(_receiver), std::move(error));
+                }, std::move(*_error));
+                return;
+            }
+
+            execution::set_stopped(std::move(_receiver));
+            return;
+        }
+
+        try {
+            if constexpr (is_void) {
+                execution::set_value(std::move(_receiver));
+            } else if constexpr (std::is_same_v<O, to_vector>) {
+                std::vector<result_t> values;
+                values.reserve(_size);
+
+                for (std::size_t i = 0; i != _size; ++i) {
+                    values.push_back(std::move(*_children[i]._result));
+                }
+
+                execution::set_value(std::move(_receiver), std::move(values));
+            } else {
+                for (std::size_t i = 0; i != _size; ++i) {
+                    *_output++ = std::move(*_children[i]._result);
+                }
+
+                execution::set_value(std::move(_receiver), std::move(_output));
+            }
+        } catch(...) {
+            execution::set_error(std::move(_receiver), std::current_exception());
+        }
+    }
+
+    auto const& get_receiver() const noexcept
+    {
+        return _receiver;
+    }
+
+    auto get_stop_token() const noexcept
+    {
+        return _stop_source.get_token();
+    }
+
+private:
+    void connect_children()
+    {
+        auto const size = static_cast<std::size_t>(std::ranges::distance(_senders));
+        if (!size) {
+            return;
+        }
+
+        child* children = _allocator.allocate(size);
+
+        std::size_t i = 0;
+        try {
+            for (auto&& sender: _senders) {
+                std::construct_at(
+                    children + i,
+                    std::move(sender),
+                    receiver_t{this, i});
+                ++i;
+            }
+        } catch (...) {
+            std::destroy_n(children, i);
+            _allocator.deallocate(children, size);
+            throw;
+        }
+
+        _children = children;
+        _size = size;
+    }
+
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename T, typename O>
+struct sender
+{
+    T _senders;
+    O _output;
+
+    template <typename R>
+    auto connect(R&& receiver) &
+    {
+        return operation<R, T, O>{
+            std::forward<R>(receiver),
+            _senders,
+            _output
+        };
+    }
+
+    template <typename R>
+    auto connect(R&& receiver) &&
+    {
+        return operation<R, T, O>{
+            std::forward<R>(receiver),
+            std::move(_senders),
+            std::move(_output)
+        };
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct when_all_range
+{
+    template <std::ranges::forward_range T>
+    constexpr auto operator () (T&& senders) const
+    {
+        return sender<std::decay_t<T>, to_vector>{
+            std::forward<T>(senders),
+            to_vector{}
+        };
+    }
+
+    template <std::ranges::forward_range T, typename O>
+        requires std::weakly_incrementable<O>
+    constexpr auto operator () (T&& senders, O output) const
+    {
+        return sender<std::decay_t<T>, O>{
+            std::forward<T>(senders),
+            std::move(output)
+        };
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename R, typename T, typename O>
+struct sender_traits
+{
+    using operation_t = operation<R, T, O>;
+
+    static constexpr auto sender_type = meta::atom<sender_t<T>>{};
+    static constexpr auto receiver_type = meta::atom<receiver<R, T, O>>{};
+
+    static constexpr auto value_types = when_all_range_values<O>(
+        sender_type,
+        receiver_type);
+
+    static constexpr auto error_types = meta::concat_unique(
+        traits::sender_errors(sender_type, receiver_type),
+        meta::list<std::exception_ptr>{}
+    );
+
+    using errors_t = decltype(error_types);
+    using values_t = decltype(value_types);
+};
+
+}   // namespace when_all_range_impl
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename R, typename T, typename O>
+struct sender_traits<when_all_range_impl::sender<T, O>, R>
+    : when_all_range_impl::sender_traits<R, T, O>
+{};
+
+////////////////////////////////////////////////////////////////////////////////
+
+constexpr auto when_all_range = when_all_range_impl::when_all_range{};
+
+}   // namespace execution
@@ -0,0 +1,177 @@
+#pragma once
+
+#include "get_deadline.hpp"
+#include "pipeable.hpp"
+#include "sender_traits.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <type_traits>
+
+namespace execution {
+namespace with_deadline_impl {
+
+template <typename S, typename R, typename D>
+struct operation;
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename S, typename R, typename D>
+struct receiver
+{
+    operation<S, R, D>* _operation;
+
+    template <typename ... Ts>
+    void set_value(Ts&& ... values)
+    {
+        execution::set_value(std::move(_operation->_receiver), std::forward<Ts>(values)...);
+    }
+
+    template <typename E>
+    void set_error(E&& error)
+    {
+        execution::set_error(std::move(_operation->_receiver), std::forward<E>(error));
+    }
+
+    void set_stopped()
+    {
+        execution::set_stopped(std::move(_operation->_receiver));
+    }
+
+    // tag_invoke
+
+    friend deadline_t tag_invoke(tag_t<get_deadline>, receiver const& self) noexcept
+    {
+        return self._operation->_deadline;
+    }
+
+    template <typename Tag, typename ... Ts>
+    friend auto tag_invoke(Tag tag, receiver const& self, Ts&& ... args)
+        noexcept(is_nothrow_tag_invocable_v<Tag, R, Ts...>)
+        -> tag_invoke_result_t<Tag, R, Ts...>
+    {
+        return tag(self._operation->_receiver, std::forward<Ts>(args)...);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+// the source is connected on start, so that the operation stays movable
+// until then
+template <typename S, typename R, typename D>
+struct operation
+{
+    using receiver_t = receiver<S, R, D>;
+    using operation_t = typename decltype(traits::sender_operation(
+        meta::atom<S>{},
+        meta::atom<receiver_t>{}))::type;
+
+    R _receiver;
+    D _limit;
+    deadline_t _deadline = no_deadline;
+    S _source;
+    std::optional<operation_t> _operation;
+
+    template <typename Sx, typename Rx>
+    operation(Sx&& sender, Rx&& receiver, D limit)
+        : _receiver(std::forward<Rx>(receiver))
+        , _limit{limit}
+        , _source(std::forward<Sx>(sender))
+    {}
+
+    void start() &
+    {
+        // a budget counts from the start; an enclosing deadline still holds
+        if constexpr (std::is_same_v<D, deadline_t>) {
+            _deadline = _limit;
+        } else {
+            _deadline = deadline_clock_t::now()
+                + std::chrono::duration_cast<deadline_clock_t::duration>(_limit);
+        }
+
+        _deadline = std::min(_deadline, execution::get_deadline(_receiver));
+
+        auto& op = _operation.emplace(
+            execution::connect(std::move(_source), receiver_t{this}));
+
+        execution::start(op);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename S, typename D>
+struct sender
+{
+    S _source;
+    D _limit;
+
+    template <typename R>
+    auto connect(R&& receiver) &
+    {
+        return operation<S, std::decay_t<R>, D>{_source, std::forward<R>(receiver), _limit};
+    }
+
+    template <typename R>
+    auto connect(R&& receiver) &&
+    {
+        return operation<S, std::decay_t<R>, D>{
+            std::move(_source),
+            std::forward<R>(receiver),
+            _limit
+        };
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename D>
+concept deadline_or_duration = std::is_same_v<D, deadline_t>
+    || requires (D d) { std::chrono::duration_cast<deadline_clock_t::duration>(d); };
+
+struct with_deadline
+{
+    template <deadline_or_duration D>
+    auto operator () (D limit) const
+    {
+        return pipeable(*this, limit);
+    }
+
+    template <typename S, deadline_or_duration D>
+    constexpr auto operator () (S&& source, D limit) const
+    {
+        return sender<std::decay_t<S>, D>{std::forward<S>(source), limit};
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename S, typename R, typename D>
+struct sender_traits
+{
+    static constexpr auto source_type = meta::atom<S>{};
+    static constexpr auto receiver_type = meta::atom<receiver<S, R, D>>{};
+
+    using operation_t = operation<S, R, D>;
+    using values_t = decltype(traits::sender_values(source_type, receiver_type));
+    using errors_t = decltype(traits::sender_errors(source_type, receiver_type));
+};
+
+}   // namespace with_deadline_impl
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename S, typename D, typename R>
+struct sender_traits<with_deadline_impl::sender<S, D>, R>
+    : with_deadline_impl::sender_traits<S, std::decay_t<R>, D>
+{};
+
+////////////////////////////////////////////////////////////////////////////////
+
+// answers get_deadline for every algorithm of the wrapped sender: either
+// a time point of deadline_clock_t or a budget that starts with the
+// operation. The earlier deadline of the receiver, if any, still applies
+constexpr auto with_deadline = with_deadline_impl::with_deadline{};
+
+}   // namespace execution
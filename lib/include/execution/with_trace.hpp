@@ -0,0 +1,178 @@
+#pragma once
+
+#include "pipeable.hpp"
+#include "sender_traits.hpp"
+#include "trace.hpp"
+
+namespace execution {
+namespace with_trace_impl {
+
+template <typename S, typename R>
+struct operation;
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename S, typename R>
+struct receiver
+{
+    operation<S, R>* _operation;
+
+    template <typename ... Ts>
+    void set_value(Ts&& ... values)
+    {
+        _operation->finish(execution::set_value, std::forward<Ts>(values)...);
+    }
+
+    template <typename E>
+    void set_error(E&& error)
+    {
+        _operation->finish(execution::set_error, std::forward<E>(error));
+    }
+
+    void set_stopped()
+    {
+        _operation->finish(execution::set_stopped);
+    }
+
+    // tag_invoke
+
+    friend auto tag_invoke(tag_t<get_tracer>, const receiver<S, R>& self) noexcept
+        -> tracer
+    {
+        return self._operation->get_tracer();
+    }
+
+    template <typename Tag, typename ... Ts>
+    friend auto tag_invoke(Tag tag, const receiver<S, R>& self, Ts&& ... args)
+        noexcept(is_nothrow_tag_invocable_v<Tag, R, Ts...>)
+        -> tag_invoke_result_t<Tag, R, Ts...>
+    {
+        return tag(self._operation->get_receiver(), std::forward<Ts>(args)...);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename S, typename R>
+struct operation
+{
+    using receiver_t = receiver<S, R>;
+    using operation_t = typename decltype(traits::sender_operation(
+        meta::atom<S>{},
+        meta::atom<receiver_t>{}))::type;
+
+    R _receiver;
+    trace_log* _log;
+    char const* _name;
+    operation_t _operation;
+
+    template <typename Sx, typename Rx>
+    operation(Sx&& sender, Rx&& receiver, trace_log* log, char const* name)
+        : _receiver(std::forward<Rx>(receiver))
+        , _log{log}
+        , _name{name}
+        , _operation(execution::connect(std::forward<Sx>(sender), receiver_t{this}))
+    {}
+
+    void start() & noexcept
+    {
+        get_tracer().async_begin(_name, this);
+        execution::start(_operation);
+    }
+
+    template <typename CPO, typename ... Ts>
+    void finish(CPO cpo, Ts&& ... values)
+    {
+        get_tracer().async_end(_name, this);
+        cpo(std::move(_receiver), std::forward<Ts>(values)...);
+    }
+
+    tracer get_tracer() const noexcept
+    {
+        return tracer{*_log};
+    }
+
+    auto const& get_receiver() const noexcept
+    {
+        return _receiver;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename S>
+struct sender
+{
+    S _source;
+    trace_log* _log;
+    char const* _name;
+
+    template <typename R>
+    auto connect(R&& receiver) &
+    {
+        return operation<S, R>{_source, std::forward<R>(receiver), _log, _name};
+    }
+
+    template <typename R>
+    auto connect(R&& receiver) &&
+    {
+        return operation<S, R>{
+            std::move(_source),
+            std::forward<R>(receiver),
+            _log,
+            _name
+        };
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct with_trace
+{
+    auto operator () (trace_log& log, char const* name) const
+    {
+        return pipeable(*this, &log, name);
+    }
+
+    template <typename S>
+    constexpr auto operator () (S&& source, trace_log* log, char const* name) const
+    {
+        return sender<std::decay_t<S>>{std::forward<S>(source), log, name};
+    }
+
+    template <typename S>
+    constexpr auto operator () (S&& source, trace_log& log, char const* name) const
+    {
+        return (*this)(std::forward<S>(source), &log, name);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename S, typename R>
+struct sender_traits
+{
+    static constexpr auto source_type = meta::atom<S>{};
+    static constexpr auto receiver_type = meta::atom<receiver<S, R>>{};
+
+    using operation_t = operation<S, R>;
+    using values_t = decltype(traits::sender_values(source_type, receiver_type));
+    using errors_t = decltype(traits::sender_errors(source_type, receiver_type));
+};
+
+}   // namespace with_trace_impl
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename S, typename R>
+struct sender_traits<with_trace_impl::sender<S>, R>
+    : with_trace_impl::sender_traits<S, R>
+{};
+
+////////////////////////////////////////////////////////////////////////////////
+
+// records the operation as an async span in `log` and hands a tracer to
+// every algorithm of the wrapped sender
+constexpr auto with_trace = with_trace_impl::with_trace{};
+
+}   // namespace execution
@@ -0,0 +1,28 @@
+#include <execution/blocking_pool.hpp>
+
+#include <chrono>
+
+namespace execution {
+
+////////////////////////////////////////////////////////////////////////////////
+
+elastic_thread_pool& blocking_pool()
+{
+    static auto* pool = new elastic_thread_pool {
+        thread_pool_options{
+            .worker_count = 0,
+            .name = "blocking",
+            // the tasks block rather than finish quickly
+            .spin_limit = 0
+        },
+        elastic_options{
+            .max_workers = blocking_pool_max_workers,
+            .grow_after = {},
+            .idle_timeout = std::chrono::seconds{10}
+        }
+    };
+
+    return *pool;
+}
+
+}   // namespace execution
@@ -0,0 +1,165 @@
+#include <execution/deadline_thread_pool.hpp>
+
+#include <algorithm>
+#include <functional>
+
+namespace execution {
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool deadline_task_queue::enqueue(task_base* task)
+{
+    return enqueue_n(task, 1);
+}
+
+bool deadline_task_queue::enqueue_n(task_base* task, std::size_t count)
+{
+    return push(no_deadline, task, nullptr, count);
+}
+
+bool deadline_task_queue::enqueue(deadline_t deadline, task_base* task, bool* late)
+{
+    *late = false;
+    return push(deadline, task, late, 1);
+}
+
+bool deadline_task_queue::enqueue(deadline_t deadline, deadline_task* task)
+{
+    return enqueue(deadline, task, &task->_late);
+}
+
+task_base* deadline_task_queue::dequeue()
+{
+    auto lock = wait();
+
+    return _heap.empty() ? nullptr : pop();
+}
+
+task_base* deadline_task_queue::try_dequeue()
+{
+    auto lock = task_queue_base::lock();
+
+    return _heap.empty() ? nullptr : pop();
+}
+
+bool deadline_task_queue::push(
+        deadline_t deadline,
+        task_base* task,
+        bool* late,
+        std::size_t count)
+{
+    mark_enqueued(task);
+
+    auto lock = task_queue_base::lock();
+
+    if (sealed()) {
+        return false;
+    }
+
+    for (auto n = count; n; --n) {
+        _heap.push_back({deadline, _seq++, task, late});
+        std::push_heap(_heap.begin(), _heap.end());
+    }
+
+    notify(lock, count);
+    return true;
+}
+
+// called with the lock held on a non empty heap
+task_base* deadline_task_queue::pop()
+{
+    std::pop_heap(_heap.begin(), _heap.end());
+    auto const e = _heap.back();
+    _heap.pop_back();
+
+    popped();
+
+    // only tasks with a deadline can be late
+    if (e._late && e._deadline < deadline_clock_t::now()) {
+        *e._late = true;
+        _late.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return e._task;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+deadline_thread_pool::deadline_thread_pool(std::size_t worker_count)
+    : deadline_thread_pool {thread_pool_options{.worker_count = worker_count}, {}}
+{}
+
+deadline_thread_pool::deadline_thread_pool(
+        thread_pool_options options,
+        deadline_options const& deadlines)
+    : thread_pool_impl {std::move(options)}
+    , _deadline_options {deadlines}
+    , _queue {thread_pool_impl::options().spin_limit}
+    , _running {thread_pool_impl::options().worker_count}
+{
+    thread_pool_impl::start();
+}
+
+deadline_thread_pool::~deadline_thread_pool()
+{
+    stop();
+}
+
+// the queue is sealed once the workers are gone
+void deadline_thread_pool::schedule(task_base* task)
+{
+    if (!_queue.enqueue(task)) {
+        std::invoke(task->_execute, task);
+    }
+}
+
+void deadline_thread_pool::schedule_n(task_base* task, std::size_t count)
+{
+    if (!_queue.enqueue_n(task, count)) {
+        for (auto n = count; n; --n) {
+            std::invoke(task->_execute, task);
+        }
+    }
+}
+
+void deadline_thread_pool::schedule(deadline_t deadline, task_base* task, bool* late)
+{
+    if (!_queue.enqueue(deadline, task, late)) {
+        std::invoke(task->_execute, task);
+    }
+}
+
+void deadline_thread_pool::schedule(deadline_t deadline, deadline_task* task)
+{
+    schedule(deadline, task, &task->_late);
+}
+
+// the workers leave once the queue is empty, including the work without a
+// deadline scheduled after stop()
+void deadline_thread_pool::stop()
+{
+    if (_should_stop.test_and_set()) {
+        return;
+    }
+
+    _queue.close();
+
+    thread_pool_impl::join();
+}
+
+// the last worker seals the queue and runs what was scheduled while the
+// others were leaving
+void deadline_thread_pool::exit_worker(std::size_t)
+{
+    if (_running.fetch_sub(1) != 1) {
+        return;
+    }
+
+    _queue.seal();
+
+    while (auto* task = _queue.try_dequeue()) {
+        std::invoke(task->_execute, task);
+    }
+}
+
+}   // namespace execution
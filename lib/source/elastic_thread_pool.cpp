@@ -0,0 +1,377 @@
+#include <execution/elastic_thread_pool.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+namespace execution {
+
+namespace {
+
+// the pool of the calling worker, if any; cleared inside a blocking_region
+thread_local elastic_thread_pool* current = nullptr;
+
+}   // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+elastic_thread_pool::blocking_region::blocking_region()
+    : _pool {std::exchange(current, nullptr)}
+{
+    if (_pool) {
+        _pool->begin_blocking();
+    }
+}
+
+elastic_thread_pool::blocking_region::~blocking_region()
+{
+    if (_pool) {
+        _pool->end_blocking();
+        current = _pool;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+elastic_thread_pool::elastic_thread_pool(std::size_t min_workers, std::size_t max_workers)
+    : elastic_thread_pool {
+        thread_pool_options{.worker_count = min_workers},
+        elastic_options{.max_workers = max_workers}
+    }
+{}
+
+elastic_thread_pool::elastic_thread_pool(
+        thread_pool_options options,
+        elastic_options const& elastic)
+    : _options {std::move(options)}
+    , _elastic {elastic}
+    , _spin {_options.spin_limit}
+{
+    if (!_elastic.max_workers) {
+        _elastic.max_workers = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    _elastic.max_workers = std::max(_elastic.max_workers, _options.worker_count);
+
+    try {
+        _monitor = worker_thread{_options.dispatcher, [this] {
+            monitor();
+        }};
+
+        std::unique_lock lock {_mtx};
+
+        for (std::size_t i = 0; i != _options.worker_count; ++i) {
+            add_worker();
+        }
+    } catch (...) {
+        stop();
+        throw;
+    }
+}
+
+elastic_thread_pool::~elastic_thread_pool()
+{
+    stop();
+}
+
+void elastic_thread_pool::stop()
+{
+    threads_t threads;
+
+    {
+        std::unique_lock lock {_mtx};
+
+        if (_stopping) {
+            return;
+        }
+
+        // workers neither start nor retire from now on
+        _stopping = true;
+
+        threads.splice(threads.end(), _threads);
+        threads.splice(threads.end(), _retired);
+    }
+
+    _cv.notify_all();
+    _monitor_cv.notify_all();
+
+    if (_monitor.joinable()) {
+        _monitor.join();
+    }
+
+    for (auto& t: threads) {
+        t.join();
+    }
+
+    // with no worker left to seal the queue, e.g. a pool without a minimum
+    // that stops while its workers are retired
+    std::unique_lock lock {_mtx};
+
+    _sealed = true;
+    auto tasks = std::exchange(_tasks, {});
+    _size.store(0, std::memory_order_relaxed);
+
+    lock.unlock();
+
+    for (auto const& e: tasks) {
+        std::invoke(e._task->_execute, e._task);
+    }
+}
+
+void elastic_thread_pool::schedule(task_base* task)
+{
+    schedule_n(task, 1);
+}
+
+void elastic_thread_pool::schedule_n(task_base* task, std::size_t count)
+{
+    mark_enqueued(task);
+
+    auto const now = elastic_clock_t::now();
+
+    std::unique_lock lock {_mtx};
+
+    if (_sealed) {
+        lock.unlock();
+
+        for (auto n = count; n; --n) {
+            std::invoke(task->_execute, task);
+        }
+        return;
+    }
+
+    for (auto n = count; n; --n) {
+        _tasks.push_back({task, now});
+    }
+
+    _size.fetch_add(count, std::memory_order_release);
+
+    if (!grow(_tasks.front()._enqueued_at)) {
+        wake_monitor();
+    }
+
+    auto const wake = std::min(count, _idle);
+    lock.unlock();
+
+    for (auto n = wake; n; --n) {
+        _cv.notify_one();
+    }
+}
+
+std::size_t elastic_thread_pool::size()
+{
+    std::unique_lock lock {_mtx};
+
+    return _workers;
+}
+
+std::size_t elastic_thread_pool::blocked()
+{
+    std::unique_lock lock {_mtx};
+
+    return _blocked;
+}
+
+void elastic_thread_pool::worker(threads_t::iterator self, std::size_t index)
+{
+    current = this;
+
+    if (_options.on_worker_start) {
+        _options.on_worker_start(index);
+    }
+
+    for (;;) {
+        _spin.wait([this] {
+            return _size.load(std::memory_order_relaxed) != 0;
+        });
+
+        std::unique_lock lock {_mtx};
+
+        if (!wait_for_task(lock, self)) {
+            break;
+        }
+
+        auto const e = _tasks.front();
+        _tasks.pop_front();
+        _size.fetch_sub(1, std::memory_order_relaxed);
+
+        // the backlog isn't served fast enough
+        if (!_tasks.empty() && !grow(e._enqueued_at)) {
+            wake_monitor();
+        }
+
+        lock.unlock();
+
+        std::invoke(e._task->_execute, e._task);
+    }
+
+    current = nullptr;
+}
+
+// false when the worker has to exit, because it retired or the pool stops
+// with an empty queue. The last worker to leave seals the queue under the
+// same lock, so nothing is left in it
+bool elastic_thread_pool::wait_for_task(
+    std::unique_lock<std::mutex>& lock,
+    threads_t::iterator self)
+{
+    auto deadline = elastic_clock_t::now() + _elastic.idle_timeout;
+
+    while (_tasks.empty()) {
+        if (_stopping) {
+            if (!--_workers) {
+                _sealed = true;
+            }
+            return false;
+        }
+
+        ++_idle;
+        auto const status = _cv.wait_until(lock, deadline);
+        --_idle;
+
+        if (status == std::cv_status::timeout && _tasks.empty() && !_stopping) {
+            if (_workers > _options.worker_count) {
+                retire(lock, self);
+                return false;
+            }
+
+            deadline = elastic_clock_t::now() + _elastic.idle_timeout;
+        }
+    }
+
+    return true;
+}
+
+// joins the worker that retired before this one, so that at most one
+// exited thread is left for stop to join
+void elastic_thread_pool::retire(
+    std::unique_lock<std::mutex>& lock,
+    threads_t::iterator self)
+{
+    --_workers;
+
+    threads_t previous;
+    previous.splice(previous.end(), _retired);
+    _retired.splice(_retired.end(), _threads, self);
+
+    lock.unlock();
+
+    for (auto& t: previous) {
+        t.join();
+    }
+}
+
+// checks the oldest task every grow_after while no worker is idle
+void elastic_thread_pool::monitor()
+{
+    // rechecks a pool at its cap, or one that grows right away
+    auto const period = std::max<elastic_clock_t::duration>(
+        _elastic.grow_after,
+        std::chrono::milliseconds{1});
+
+    std::unique_lock lock {_mtx};
+
+    while (!_stopping) {
+        if (_tasks.empty() || _idle) {
+            _monitor_parked = true;
+            _monitor_cv.wait(lock);
+            _monitor_parked = false;
+            continue;
+        }
+
+        auto const& oldest = _tasks.front();
+        auto const due = std::max(oldest._enqueued_at, _last_growth) + _elastic.grow_after;
+
+        if (elastic_clock_t::now() < due) {
+            _monitor_cv.wait_until(lock, due);
+        } else if (!grow(oldest._enqueued_at)) {
+            _monitor_cv.wait_for(lock, period);
+        }
+    }
+}
+
+// called with the lock held when tasks are left waiting
+void elastic_thread_pool::wake_monitor()
+{
+    if (_monitor_parked && !_idle) {
+        _monitor_cv.notify_one();
+    }
+}
+
+// called with the lock held, which the new worker waits for before it
+// looks at its handle
+void elastic_thread_pool::add_worker()
+{
+    auto const index = _next_index++;
+    auto self = _threads.emplace(_threads.end());
+
+    try {
+        *self = worker_thread{_options.worker(index), [this, self, index] {
+            worker(self, index);
+        }};
+    } catch (...) {
+        _threads.erase(self);
+        throw;
+    }
+
+    ++_workers;
+}
+
+// called with the lock held, for the oldest task that is still waiting;
+// true if a worker was added
+bool elastic_thread_pool::grow(elastic_clock_t::time_point enqueued_at)
+{
+    if (_stopping || _idle || _workers - _blocked >= _elastic.max_workers) {
+        return false;
+    }
+
+    auto const now = elastic_clock_t::now();
+
+    // with every worker blocked or retired, nothing would take the task
+    if (_workers != _blocked) {
+        if (now - enqueued_at < _elastic.grow_after
+            || now - _last_growth < _elastic.grow_after) {
+            return false;
+        }
+    }
+
+    _last_growth = now;
+
+    try {
+        add_worker();
+    } catch (std::system_error const&) {
+        // the tasks still run on the workers there are
+        return false;
+    }
+
+    return true;
+}
+
+void elastic_thread_pool::begin_blocking()
+{
+    std::unique_lock lock {_mtx};
+
+    ++_blocked;
+
+    if (_stopping || _idle || _workers - _blocked >= _elastic.max_workers) {
+        return;
+    }
+
+    try {
+        add_worker();
+    } catch (std::system_error const&) {
+        // the other workers take over once the task is done blocking
+    }
+}
+
+// the compensating worker retires once it stays idle
+void elastic_thread_pool::end_blocking()
+{
+    std::unique_lock lock {_mtx};
+
+    --_blocked;
+}
+
+}   // namespace execution
@@ -0,0 +1,75 @@
+#include <execution/monotonic_arena.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <new>
+
+namespace execution {
+
+////////////////////////////////////////////////////////////////////////////////
+
+monotonic_arena::monotonic_arena(std::size_t initial_size) noexcept
+    : _next_chunk_size{std::max<std::size_t>(initial_size, 64)}
+    , _initial_chunk_size{_next_chunk_size}
+{}
+
+monotonic_arena::monotonic_arena(void* buffer, std::size_t size) noexcept
+    : _current{static_cast<std::byte*>(buffer)}
+    , _available{size}
+    , _next_chunk_size{std::max<std::size_t>(size, 64)}
+    , _buffer{static_cast<std::byte*>(buffer)}
+    , _buffer_size{size}
+    , _initial_chunk_size{_next_chunk_size}
+{}
+
+monotonic_arena::~monotonic_arena()
+{
+    release();
+}
+
+void* monotonic_arena::allocate(std::size_t size, std::size_t alignment)
+{
+    void* ptr = _current;
+    if (!std::align(alignment, size, ptr, _available)) {
+        grow(size, alignment);
+        ptr = _current;
+        std::align(alignment, size, ptr, _available);
+    }
+
+    _current = static_cast<std::byte*>(ptr) + size;
+    _available -= size;
+
+    return ptr;
+}
+
+void monotonic_arena::release() noexcept
+{
+    while (_chunks) {
+        auto* next = _chunks->_next;
+        ::operator delete(_chunks, _chunks->_size);
+        _chunks = next;
+    }
+
+    _current = _buffer;
+    _available = _buffer_size;
+    _next_chunk_size = _initial_chunk_size;
+}
+
+void monotonic_arena::grow(std::size_t size, std::size_t alignment)
+{
+    // chunks grow geometrically to keep the number of allocations small
+    auto const chunk_size = std::max(
+        _next_chunk_size,
+        sizeof(chunk) + size + alignment);
+
+    auto* c = static_cast<chunk*>(::operator new(chunk_size));
+    c->_next = _chunks;
+    c->_size = chunk_size;
+    _chunks = c;
+
+    _current = reinterpret_cast<std::byte*>(c + 1);
+    _available = chunk_size - sizeof(chunk);
+    _next_chunk_size = chunk_size * 2;
+}
+
+}   // namespace execution
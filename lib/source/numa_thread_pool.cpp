@@ -0,0 +1,289 @@
+#include <execution/numa_thread_pool.hpp>
+
+#include <functional>
+#include <system_error>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace execution {
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct worker_state
+{
+    numa_thread_pool const* _pool = nullptr;
+    std::size_t _node = numa_thread_pool::no_node;
+};
+
+thread_local worker_state current_worker;
+
+// the CPUs of `cpus` the process may run on: pinning stays best effort
+// when the cgroup doesn't include the whole node. All of them when that
+// can't be told
+std::vector<int> allowed_cpus(std::vector<int> const& cpus)
+{
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+
+    if (sched_getaffinity(0, sizeof(set), &set)) {
+        return cpus;
+    }
+
+    std::vector<int> allowed;
+    for (int cpu: cpus) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE && CPU_ISSET(cpu, &set)) {
+            allowed.push_back(cpu);
+        }
+    }
+    return allowed;
+#else
+    return cpus;
+#endif
+}
+
+// `per_node` or one worker per allowed CPU of the node; none when the
+// process may not run on the node at all
+std::size_t node_worker_count(std::vector<int> const& allowed, std::size_t per_node)
+{
+    if (allowed.empty()) {
+        return 0;
+    }
+
+    return per_node ? per_node : allowed.size();
+}
+
+thread_pool_options worker_options(
+        numa_topology const& topology,
+        std::size_t per_node,
+        thread_pool_options options)
+{
+    options.worker_count = 0;
+    options.worker_cpus.clear();
+
+    for (auto const& node: topology.nodes()) {
+        auto allowed = allowed_cpus(node.cpus);
+        auto const count = node_worker_count(allowed, per_node);
+
+        options.worker_count += count;
+        options.worker_cpus.insert(options.worker_cpus.end(), count, allowed);
+    }
+
+    // nothing would ever run the tasks
+    if (!options.worker_count) {
+        throw std::system_error{
+            std::make_error_code(std::errc::invalid_argument),
+            "numa_thread_pool: the process may run on no CPU of the topology"};
+    }
+
+    return options;
+}
+
+}   // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+numa_task_queue::numa_task_queue(
+        numa_topology const& topology,
+        std::uint32_t spin_limit)
+    : task_queue_base {spin_limit}
+    , _queues {std::make_unique<node_queue[]>(topology.size())}
+{
+    _steal_order.reserve(topology.size());
+    for (std::size_t n = 0; n != topology.size(); ++n) {
+        _steal_order.push_back(topology.neighbours(n));
+    }
+}
+
+bool numa_task_queue::enqueue(std::size_t node, task_base* task)
+{
+    return enqueue_n(node, task, 1);
+}
+
+bool numa_task_queue::enqueue_n(std::size_t node, task_base* task, std::size_t count)
+{
+    mark_enqueued(task);
+
+    auto lock = task_queue_base::lock();
+
+    if (sealed()) {
+        return false;
+    }
+
+    {
+        auto& q = _queues[node];
+        std::unique_lock node_lock {q._mtx};
+        for (auto n = count; n; --n) {
+            q._tasks.push(task);
+        }
+    }
+
+    notify(lock, count);
+    return true;
+}
+
+task_base* numa_task_queue::dequeue(std::size_t node)
+{
+    for (;;) {
+        if (auto* task = try_dequeue(node)) {
+            return task;
+        }
+
+        // the tasks are popped without the lock: it only tells whether
+        // there is still one somewhere
+        auto lock = wait();
+
+        if (!size()) {
+            return nullptr;
+        }
+    }
+}
+
+task_base* numa_task_queue::try_dequeue(std::size_t node)
+{
+    if (!size()) {
+        return nullptr;
+    }
+
+    if (auto* task = try_pop_local(node)) {
+        return task;
+    }
+
+    for (auto other: _steal_order[node]) {
+        if (auto* task = try_pop_local(other)) {
+            return task;
+        }
+    }
+
+    return nullptr;
+}
+
+task_base* numa_task_queue::try_pop_local(std::size_t node)
+{
+    auto& q = _queues[node];
+    std::unique_lock lock {q._mtx};
+
+    if (q._tasks.empty()) {
+        return nullptr;
+    }
+
+    auto* task = q._tasks.front();
+    q._tasks.pop();
+
+    popped();
+
+    return task;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+numa_thread_pool::numa_thread_pool()
+    : numa_thread_pool {numa_topology::discover()}
+{}
+
+numa_thread_pool::numa_thread_pool(
+        numa_topology topology,
+        std::size_t workers_per_node,
+        thread_pool_options options)
+    : thread_pool_impl {worker_options(topology, workers_per_node, std::move(options))}
+    , _topology {std::move(topology)}
+{
+    _node_workers.reserve(_topology.size() + 1);
+
+    for (std::size_t n = 0; n != _topology.size(); ++n) {
+        _node_workers.push_back(_worker_nodes.size());
+
+        auto const count = node_worker_count(
+            allowed_cpus(_topology.nodes()[n].cpus),
+            workers_per_node);
+
+        _worker_nodes.insert(_worker_nodes.end(), count, n);
+    }
+
+    _node_workers.push_back(_worker_nodes.size());
+
+    thread_pool_impl::start();
+}
+
+numa_thread_pool::~numa_thread_pool()
+{
+    stop();
+}
+
+// the queue is sealed once the workers are gone
+void numa_thread_pool::schedule(task_base* task)
+{
+    auto node = current_node();
+
+    if (node == no_node) {
+        node = _next_node.fetch_add(1, std::memory_order_relaxed) % _topology.size();
+    }
+
+    schedule_on(node, task);
+}
+
+void numa_thread_pool::schedule_on(std::size_t node, task_base* task)
+{
+    if (!_queue.enqueue(node, task)) {
+        std::invoke(task->_execute, task);
+    }
+}
+
+void numa_thread_pool::schedule_on(std::size_t node, task_base* task, std::size_t count)
+{
+    if (!_queue.enqueue_n(node, task, count)) {
+        for (auto n = count; n; --n) {
+            std::invoke(task->_execute, task);
+        }
+    }
+}
+
+// the workers leave once every node is empty
+void numa_thread_pool::stop()
+{
+    if (_should_stop.test_and_set()) {
+        return;
+    }
+
+    _queue.close();
+
+    thread_pool_impl::join();
+}
+
+std::size_t numa_thread_pool::current_node() const noexcept
+{
+    return current_worker._pool == this
+        ? current_worker._node
+        : no_node;
+}
+
+void numa_thread_pool::init_worker(std::size_t index)
+{
+    current_worker = {this, _worker_nodes[index]};
+}
+
+// the last worker seals the queue and runs what was scheduled while the
+// others were leaving
+void numa_thread_pool::exit_worker(std::size_t index)
+{
+    if (_running.fetch_sub(1) != 1) {
+        return;
+    }
+
+    _queue.seal();
+
+    while (auto* task = _queue.try_dequeue(_worker_nodes[index])) {
+        std::invoke(task->_execute, task);
+    }
+}
+
+task_base* numa_thread_pool::worker_queue::dequeue()
+{
+    return _queue->dequeue(current_worker._node);
+}
+
+}   // namespace execution
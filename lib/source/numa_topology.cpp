@@ -0,0 +1,176 @@
+#include <execution/numa_topology.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <thread>
+
+namespace execution {
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::string read_file(std::filesystem::path const& path)
+{
+    std::ifstream file {path};
+    std::stringstream ss;
+    ss << file.rdbuf();
+    return ss.str();
+}
+
+int parse_int(std::string_view str)
+{
+    int value = 0;
+    std::from_chars(str.data(), str.data() + str.size(), value);
+    return value;
+}
+
+// "node12" -> 12
+bool parse_node_id(std::string const& name, int& id)
+{
+    constexpr std::string_view prefix = "node";
+
+    if (name.size() <= prefix.size() || name.compare(0, prefix.size(), prefix)) {
+        return false;
+    }
+
+    auto const* first = name.data() + prefix.size();
+    auto const* last = name.data() + name.size();
+    auto const [ptr, ec] = std::from_chars(first, last, id);
+
+    return ec == std::errc{} && ptr == last;
+}
+
+}   // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::vector<int> parse_cpu_list(std::string_view str)
+{
+    std::vector<int> cpus;
+
+    while (!str.empty()) {
+        auto const comma = str.find(',');
+        auto range = str.substr(0, comma);
+        str = comma == str.npos ? std::string_view{} : str.substr(comma + 1);
+
+        while (!range.empty() && std::isspace(static_cast<unsigned char>(range.back()))) {
+            range.remove_suffix(1);
+        }
+
+        if (range.empty()) {
+            continue;
+        }
+
+        auto const dash = range.find('-');
+        int const first = parse_int(range.substr(0, dash));
+        int const last = dash == range.npos
+            ? first
+            : parse_int(range.substr(dash + 1));
+
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+
+    return cpus;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+numa_topology::numa_topology(std::vector<numa_node> nodes)
+    : _nodes {std::move(nodes)}
+{}
+
+numa_topology numa_topology::discover(std::filesystem::path const& root)
+{
+    std::vector<numa_node> nodes;
+
+    std::error_code ec;
+    for (auto const& entry: std::filesystem::directory_iterator{root, ec}) {
+        numa_node node;
+        if (!parse_node_id(entry.path().filename().string(), node.id)) {
+            continue;
+        }
+
+        node.cpus = parse_cpu_list(read_file(entry.path() / "cpulist"));
+
+        // memory-only nodes have no workers to run on
+        if (node.cpus.empty()) {
+            continue;
+        }
+
+        std::istringstream distances {read_file(entry.path() / "distance")};
+        for (int d; distances >> d; ) {
+            node.distances.push_back(d);
+        }
+
+        nodes.push_back(std::move(node));
+    }
+
+    if (nodes.empty()) {
+        return uniform(std::max(1u, std::thread::hardware_concurrency()));
+    }
+
+    std::sort(nodes.begin(), nodes.end(), [] (auto const& lhs, auto const& rhs) {
+        return lhs.id < rhs.id;
+    });
+
+    // sysfs distances are indexed by node id; keep only the nodes we use
+    for (auto& node: nodes) {
+        std::vector<int> distances;
+        distances.reserve(nodes.size());
+
+        for (auto const& other: nodes) {
+            auto const i = static_cast<std::size_t>(other.id);
+            distances.push_back(i < node.distances.size()
+                ? node.distances[i]
+                : (other.id == node.id ? 10 : 20));
+        }
+
+        node.distances = std::move(distances);
+    }
+
+    return numa_topology{std::move(nodes)};
+}
+
+numa_topology numa_topology::uniform(std::size_t cpu_count)
+{
+    numa_node node;
+    node.cpus.resize(cpu_count);
+    std::iota(node.cpus.begin(), node.cpus.end(), 0);
+    node.distances = {10};
+
+    return numa_topology{{std::move(node)}};
+}
+
+std::vector<std::size_t> numa_topology::neighbours(std::size_t node) const
+{
+    std::vector<std::size_t> order;
+    order.reserve(_nodes.size());
+
+    for (std::size_t i = 0; i != _nodes.size(); ++i) {
+        if (i != node) {
+            order.push_back(i);
+        }
+    }
+
+    auto const& distances = _nodes[node].distances;
+    auto const distance = [&] (std::size_t i) {
+        return i < distances.size() ? distances[i] : 20;
+    };
+
+    std::stable_sort(order.begin(), order.end(), [&] (auto lhs, auto rhs) {
+        return distance(lhs) < distance(rhs);
+    });
+
+    return order;
+}
+
+}   // namespace execution
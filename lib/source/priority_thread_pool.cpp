@@ -0,0 +1,227 @@
+#include <execution/priority_thread_pool.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+namespace execution {
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+
+priority_options normalized(priority_options options)
+{
+    options.levels = std::max<std::size_t>(options.levels, 1);
+    options.default_level = std::min(options.default_level, options.levels - 1);
+    return options;
+}
+
+}   // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+multilevel_task_queue::multilevel_task_queue(
+        priority_options const& options,
+        std::uint32_t spin_limit)
+    : task_queue_base {spin_limit}
+    , _options {normalized(options)}
+    , _levels {std::make_unique<level[]>(_options.levels)}
+{}
+
+bool multilevel_task_queue::enqueue(std::size_t priority, task_base* task)
+{
+    return enqueue_n(priority, task, 1);
+}
+
+bool multilevel_task_queue::enqueue_n(
+        std::size_t priority,
+        task_base* task,
+        std::size_t count)
+{
+    mark_enqueued(task);
+
+    auto& l = _levels[std::min(priority, _options.levels - 1)];
+
+    auto lock = task_queue_base::lock();
+
+    if (sealed()) {
+        return false;
+    }
+
+    // a task enqueued now has the age of the ones dequeued from now on
+    for (auto n = count; n; --n) {
+        l._tasks.push_back({task, _served});
+    }
+
+    notify(lock, count);
+    return true;
+}
+
+task_base* multilevel_task_queue::dequeue()
+{
+    auto lock = wait();
+
+    return size() ? pop() : nullptr;
+}
+
+task_base* multilevel_task_queue::try_dequeue()
+{
+    auto lock = task_queue_base::lock();
+
+    return size() ? pop() : nullptr;
+}
+
+std::vector<priority_level_snapshot> multilevel_task_queue::level_metrics()
+{
+    std::vector<priority_level_snapshot> s(_options.levels);
+
+    auto lock = task_queue_base::lock();
+
+    for (std::size_t i = 0; i != _options.levels; ++i) {
+        auto const& l = _levels[i];
+
+        s[i].depth = l._tasks.size();
+        l._metrics.snapshot(s[i]);
+    }
+
+    return s;
+}
+
+// called with the lock held on a non empty queue
+task_base* multilevel_task_queue::pop()
+{
+    std::size_t best = _options.levels;
+    std::size_t best_rank = 0;
+    std::uint64_t best_seq = 0;
+
+    for (std::size_t i = 0; i != _options.levels; ++i) {
+        auto const& tasks = _levels[i]._tasks;
+        if (tasks.empty()) {
+            continue;
+        }
+
+        auto const seq = tasks.front()._seq;
+        auto const boost = _options.aging_period
+            ? (_served - seq) / _options.aging_period
+            : 0;
+        auto const rank = i > boost ? i - boost : 0;
+
+        if (best == _options.levels
+            || rank < best_rank
+            || (rank == best_rank && seq < best_seq))
+        {
+            best = i;
+            best_rank = rank;
+            best_seq = seq;
+        }
+    }
+
+    auto& l = _levels[best];
+    auto* task = l._tasks.front()._task;
+    l._tasks.pop_front();
+
+    ++_served;
+    popped();
+
+    if constexpr (metrics_enabled) {
+        // a more urgent level was waiting
+        bool const aged = std::any_of(_levels.get(), _levels.get() + best,
+            [] (level const& other) {
+                return !other._tasks.empty();
+            });
+
+        l._metrics.record(task, aged);
+    }
+
+    return task;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+priority_thread_pool::priority_thread_pool(std::size_t worker_count)
+    : priority_thread_pool {thread_pool_options{.worker_count = worker_count}, {}}
+{}
+
+priority_thread_pool::priority_thread_pool(
+        thread_pool_options options,
+        priority_options const& priorities)
+    : thread_pool_impl {std::move(options)}
+    , _queue {priorities, thread_pool_impl::options().spin_limit}
+    , _running {thread_pool_impl::options().worker_count}
+{
+    thread_pool_impl::start();
+}
+
+priority_thread_pool::~priority_thread_pool()
+{
+    stop();
+}
+
+void priority_thread_pool::schedule(task_base* task)
+{
+    schedule(_queue.default_level(), task);
+}
+
+// the queue is sealed once the workers are gone
+void priority_thread_pool::schedule(std::size_t priority, task_base* task)
+{
+    if (!_queue.enqueue(priority, task)) {
+        std::invoke(task->_execute, task);
+    }
+}
+
+void priority_thread_pool::schedule_n(task_base* task, std::size_t count)
+{
+    if (!_queue.enqueue_n(_queue.default_level(), task, count)) {
+        for (auto n = count; n; --n) {
+            std::invoke(task->_execute, task);
+        }
+    }
+}
+
+// the workers leave once the queue is empty, whatever the priorities and
+// the ages of the tasks
+void priority_thread_pool::stop()
+{
+    if (_should_stop.test_and_set()) {
+        return;
+    }
+
+    _queue.close();
+
+    thread_pool_impl::join();
+}
+
+// the last worker seals the queue and runs what was scheduled while the
+// others were leaving
+void priority_thread_pool::exit_worker(std::size_t)
+{
+    if (_running.fetch_sub(1) != 1) {
+        return;
+    }
+
+    _queue.seal();
+
+    while (auto* task = _queue.try_dequeue()) {
+        std::invoke(task->_execute, task);
+    }
+}
+
+pool_metrics_snapshot priority_thread_pool::metrics()
+{
+    auto s = thread_pool_impl::metrics();
+
+    if constexpr (metrics_enabled) {
+        s.levels = _queue.level_metrics();
+    }
+
+    return s;
+}
+
+priority_thread_pool::scheduler_t priority_thread_pool::get_scheduler() noexcept
+{
+    return {this, _queue.default_level()};
+}
+
+}   // namespace execution
@@ -0,0 +1,64 @@
+#include <execution/run_loop.hpp>
+
+#include <cassert>
+#include <functional>
+
+namespace execution {
+
+////////////////////////////////////////////////////////////////////////////////
+
+run_loop::~run_loop()
+{
+    assert(!_head);
+}
+
+void run_loop::schedule(task_base* task)
+{
+    std::unique_lock lock {_mtx};
+
+    task->_next = nullptr;
+    if (_tail) {
+        _tail->_next = task;
+    } else {
+        _head = task;
+    }
+    _tail = task;
+
+    _cv.notify_one();
+}
+
+void run_loop::run()
+{
+    while (auto* task = dequeue()) {
+        std::invoke(task->_execute, task);
+    }
+}
+
+void run_loop::finish()
+{
+    std::unique_lock lock {_mtx};
+
+    _finishing = true;
+    _cv.notify_all();
+}
+
+task_base* run_loop::dequeue()
+{
+    std::unique_lock lock {_mtx};
+
+    _cv.wait(lock, [this] {
+        return _head || _finishing;
+    });
+
+    task_base* task = _head;
+    if (task) {
+        _head = task->_next;
+        if (!_head) {
+            _tail = nullptr;
+        }
+    }
+
+    return task;
+}
+
+}   // namespace execution
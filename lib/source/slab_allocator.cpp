@@ -0,0 +1,106 @@
+#include <execution/slab_allocator.hpp>
+
+#include <bit>
+#include <cstdint>
+#include <new>
+
+namespace execution::slab_impl {
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+
+constexpr std::size_t class_count =
+    std::countr_zero(max_block_size) - std::countr_zero(min_block_size) + 1;
+
+struct free_block
+{
+    free_block* _next;
+};
+
+// trivially destructible so that it can still be used by destructors of
+// other thread_local objects, `cache_cleanup` frees the blocks
+struct thread_cache
+{
+    free_block* _blocks[class_count];
+    std::uint32_t _count[class_count];
+    bool _registered;
+    bool _destroyed;
+};
+
+thread_local thread_cache cache {};
+
+struct cache_cleanup
+{
+    ~cache_cleanup()
+    {
+        for (std::size_t i = 0; i != class_count; ++i) {
+            while (auto* block = cache._blocks[i]) {
+                cache._blocks[i] = block->_next;
+                ::operator delete(block);
+            }
+            cache._count[i] = 0;
+        }
+
+        cache._destroyed = true;
+    }
+};
+
+std::size_t size_class(std::size_t size) noexcept
+{
+    size = size < min_block_size ? min_block_size : size;
+    return std::bit_width(size - 1) - std::countr_zero(min_block_size);
+}
+
+std::size_t block_size(std::size_t index) noexcept
+{
+    return min_block_size << index;
+}
+
+}   // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+void* allocate(std::size_t size)
+{
+    if (size > max_block_size) {
+        return ::operator new(size);
+    }
+
+    auto const index = size_class(size);
+
+    if (auto* block = cache._blocks[index]) {
+        cache._blocks[index] = block->_next;
+        --cache._count[index];
+        return block;
+    }
+
+    return ::operator new(block_size(index));
+}
+
+void deallocate(void* ptr, std::size_t size) noexcept
+{
+    if (size > max_block_size) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    auto const index = size_class(size);
+
+    if (cache._destroyed || cache._count[index] == max_cached_blocks) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    if (!cache._registered) {
+        thread_local cache_cleanup cleanup;
+        cache._registered = true;
+    }
+
+    auto* block = static_cast<free_block*>(ptr);
+    block->_next = cache._blocks[index];
+    cache._blocks[index] = block;
+    ++cache._count[index];
+}
+
+}   // namespace execution::slab_impl
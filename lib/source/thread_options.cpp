@@ -0,0 +1,272 @@
+#include <execution/thread_options.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <future>
+#include <memory>
+#include <system_error>
+#include <utility>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#endif
+
+namespace execution {
+
+namespace {
+
+// without the terminating null, the limit of pthread_setname_np
+constexpr std::size_t max_name_size = 15;
+
+}   // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+thread_options thread_pool_options::worker(std::size_t index) const
+{
+    thread_options options;
+
+    // the prefix is truncated rather than the index
+    if (!name.empty()) {
+        auto const suffix = "-" + std::to_string(index);
+        auto const room = max_name_size - std::min(suffix.size(), max_name_size);
+
+        options.name = name.substr(0, room) + suffix;
+    }
+
+    if (!worker_cpus.empty()) {
+        options.cpus = worker_cpus[index % worker_cpus.size()];
+    }
+
+    options.stack_size = stack_size;
+    options.policy = policy;
+    options.priority = priority;
+    options.nice = nice;
+
+    return options;
+}
+
+#if defined(__linux__)
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+
+void check(int ec, char const* what)
+{
+    if (ec) {
+        throw std::system_error{ec, std::system_category(), what};
+    }
+}
+
+int native_policy(sched_policy policy)
+{
+    switch (policy) {
+        case sched_policy::normal: return SCHED_OTHER;
+        case sched_policy::batch: return SCHED_BATCH;
+        case sched_policy::idle: return SCHED_IDLE;
+        case sched_policy::fifo: return SCHED_FIFO;
+        case sched_policy::round_robin: return SCHED_RR;
+    }
+    return SCHED_OTHER;
+}
+
+struct attributes
+{
+    pthread_attr_t _attr;
+
+    explicit attributes(thread_options const& options)
+    {
+        check(pthread_attr_init(&_attr), "pthread_attr_init");
+
+        try {
+            apply(options);
+        } catch (...) {
+            pthread_attr_destroy(&_attr);
+            throw;
+        }
+    }
+
+    ~attributes()
+    {
+        pthread_attr_destroy(&_attr);
+    }
+
+    void apply(thread_options const& options)
+    {
+        if (options.stack_size) {
+            check(pthread_attr_setstacksize(&_attr, options.stack_size),
+                "pthread_attr_setstacksize");
+        }
+
+        if (!options.cpus.empty()) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+
+            for (int cpu: options.cpus) {
+                if (cpu < 0 || cpu >= CPU_SETSIZE) {
+                    check(EINVAL, "thread_options::cpus");
+                }
+                CPU_SET(cpu, &set);
+            }
+
+            check(pthread_attr_setaffinity_np(&_attr, sizeof(set), &set),
+                "pthread_attr_setaffinity_np");
+        }
+
+        if (options.policy != sched_policy::normal) {
+            bool const realtime = options.policy == sched_policy::fifo
+                || options.policy == sched_policy::round_robin;
+
+            sched_param param {};
+            param.sched_priority = realtime ? options.priority : 0;
+
+            check(pthread_attr_setinheritsched(&_attr, PTHREAD_EXPLICIT_SCHED),
+                "pthread_attr_setinheritsched");
+            check(pthread_attr_setschedpolicy(&_attr, native_policy(options.policy)),
+                "pthread_attr_setschedpolicy");
+            check(pthread_attr_setschedparam(&_attr, &param),
+                "pthread_attr_setschedparam");
+        }
+    }
+};
+
+// the part of the setup that can only be done by the thread itself
+struct start_state
+{
+    std::function<void()> _func;
+    std::string _name;
+    std::optional<int> _nice;
+
+    // 0 or the error of the setup
+    std::promise<int> _status;
+
+    int setup() const noexcept
+    {
+        if (!_name.empty()) {
+            auto const name = _name.substr(0, max_name_size);
+            if (int ec = pthread_setname_np(pthread_self(), name.c_str())) {
+                return ec;
+            }
+        }
+
+        if (_nice) {
+            auto const tid = static_cast<id_t>(::syscall(SYS_gettid));
+            if (::setpriority(PRIO_PROCESS, tid, *_nice) == -1) {
+                return errno;
+            }
+        }
+
+        return 0;
+    }
+};
+
+void* run(void* arg)
+{
+    std::unique_ptr<start_state> state {static_cast<start_state*>(arg)};
+
+    int const ec = state->setup();
+    state->_status.set_value(ec);
+
+    if (!ec) {
+        state->_func();
+    }
+
+    return nullptr;
+}
+
+}   // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+worker_thread::worker_thread(thread_options const& options, std::function<void()> func)
+{
+    attributes attr {options};
+
+    auto state = std::make_unique<start_state>(start_state{
+        std::move(func),
+        options.name,
+        options.nice,
+        {}
+    });
+
+    auto status = state->_status.get_future();
+
+    check(pthread_create(&_handle, &attr._attr, &run, state.get()), "pthread_create");
+    state.release();
+
+    if (int ec = status.get()) {
+        pthread_join(_handle, nullptr);
+        check(ec, "thread_options");
+    }
+
+    _joinable = true;
+}
+
+worker_thread::worker_thread(worker_thread&& other) noexcept
+    : _handle {other._handle}
+    , _joinable {std::exchange(other._joinable, false)}
+{}
+
+worker_thread& worker_thread::operator = (worker_thread&& other) noexcept
+{
+    if (_joinable) {
+        std::terminate();
+    }
+
+    _handle = other._handle;
+    _joinable = std::exchange(other._joinable, false);
+
+    return *this;
+}
+
+worker_thread::~worker_thread()
+{
+    if (_joinable) {
+        std::terminate();
+    }
+}
+
+bool worker_thread::joinable() const noexcept
+{
+    return _joinable;
+}
+
+void worker_thread::join()
+{
+    check(pthread_join(_handle, nullptr), "pthread_join");
+    _joinable = false;
+}
+
+#else
+
+////////////////////////////////////////////////////////////////////////////////
+
+worker_thread::worker_thread(thread_options const&, std::function<void()> func)
+    : _thread {std::move(func)}
+{}
+
+worker_thread::worker_thread(worker_thread&& other) noexcept = default;
+
+worker_thread& worker_thread::operator = (worker_thread&& other) noexcept = default;
+
+worker_thread::~worker_thread() = default;
+
+bool worker_thread::joinable() const noexcept
+{
+    return _thread.joinable();
+}
+
+void worker_thread::join()
+{
+    _thread.join();
+}
+
+#endif
+
+}   // namespace execution
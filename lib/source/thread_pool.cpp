@@ -1,11 +1,20 @@
 #include <execution/thread_pool.hpp>
 
+#include <functional>
+#include <utility>
+
 namespace execution {
 
 ////////////////////////////////////////////////////////////////////////////////
 
 thread_pool::thread_pool(std::size_t worker_count)
-    : thread_pool_impl {worker_count}
+    : thread_pool {thread_pool_options{.worker_count = worker_count}}
+{}
+
+thread_pool::thread_pool(thread_pool_options options)
+    : thread_pool_impl {std::move(options)}
+    , _queue {thread_pool_impl::options().spin_limit}
+    , _running {thread_pool_impl::options().worker_count}
 {
     thread_pool_impl::start();
 }
@@ -15,22 +24,122 @@ thread_pool::~thread_pool()
     stop();
 }
 
+// the queue is sealed once the workers are gone
 void thread_pool::schedule(task_base* task)
 {
-    _queue.enqueue(task);
+    if (!_queue.enqueue(task)) {
+        std::invoke(task->_execute, task);
+    }
+}
+
+void thread_pool::schedule_n(task_base* task, std::size_t count)
+{
+    if (!_queue.enqueue_n(task, count)) {
+        for (auto n = count; n; --n) {
+            std::invoke(task->_execute, task);
+        }
+    }
+}
+
+void thread_pool::schedule_batch(task_base* first, task_base* last)
+{
+    if (_queue.enqueue_batch(first, last)) {
+        return;
+    }
+
+    for (auto* task = first;;) {
+        // the task may be gone once it runs
+        auto* next = task == last ? nullptr : task->_next;
+        std::invoke(task->_execute, task);
+
+        if (!next) {
+            break;
+        }
+        task = next;
+    }
 }
 
 void thread_pool::stop()
 {
-    if (_should_stop.test_and_set()) {
+    _queue.close();
+    join_workers();
+}
+
+void thread_pool::stop(std::chrono::steady_clock::time_point deadline)
+{
+    _queue.close();
+
+    {
+        std::unique_lock lock {_exit_mtx};
+
+        _exit_cv.wait_until(lock, deadline, [this] {
+            return _drained;
+        });
+    }
+
+    request_stop();
+    join_workers();
+}
+
+void thread_pool::request_stop()
+{
+    _stop_requested.store(true, std::memory_order_release);
+    _queue.close();
+}
+
+void thread_pool::join_workers()
+{
+    std::call_once(_joined, [this] {
+        thread_pool_impl::join();
+    });
+}
+
+// the last worker seals the queue and runs what was scheduled while the
+// others were leaving
+void thread_pool::exit_worker(std::size_t)
+{
+    std::unique_lock lock {_exit_mtx};
+
+    if (--_running) {
         return;
     }
 
-    for (std::size_t n = thread_pool_impl::size(); n; --n) {
-        _queue.enqueue(nullptr);
+    lock.unlock();
+
+    _queue.seal();
+
+    while (auto* task = _queue.try_dequeue()) {
+        std::invoke(task->_execute, task);
     }
 
-    thread_pool_impl::join();
+    lock.lock();
+
+    _drained = true;
+    auto* joiner = std::exchange(_joiners, nullptr);
+
+    lock.unlock();
+
+    _exit_cv.notify_all();
+
+    while (joiner) {
+        auto* task = std::exchange(joiner, joiner->_next);
+        std::invoke(task->_execute, task);
+    }
+}
+
+void thread_pool::add_joiner(task_base* task)
+{
+    std::unique_lock lock {_exit_mtx};
+
+    if (!_drained) {
+        task->_next = _joiners;
+        _joiners = task;
+        return;
+    }
+
+    lock.unlock();
+
+    std::invoke(task->_execute, task);
 }
 
 }   // namespace execution
@@ -5,8 +5,13 @@ namespace execution {
 ////////////////////////////////////////////////////////////////////////////////
 
 timed_thread_pool::timed_thread_pool(std::size_t worker_count)
-    : thread_pool_impl {worker_count}
-    , _dispatcher {&timed_thread_pool::dispatcher, this}
+    : timed_thread_pool {thread_pool_options{.worker_count = worker_count}}
+{}
+
+timed_thread_pool::timed_thread_pool(thread_pool_options options)
+    : thread_pool_impl {std::move(options)}
+    , _queue {thread_pool_impl::options().spin_limit}
+    , _dispatcher {thread_pool_impl::options().dispatcher, [this] { dispatcher(); }}
 {
     thread_pool_impl::start();
 }
@@ -21,6 +26,16 @@ void timed_thread_pool::schedule(task_base* task)
     _queue.enqueue_lo(task);
 }
 
+void timed_thread_pool::schedule_n(task_base* task, std::size_t count)
+{
+    _queue.enqueue_lo_n(task, count);
+}
+
+void timed_thread_pool::schedule_batch(task_base* first, task_base* last)
+{
+    _queue.enqueue_lo_batch(first, last);
+}
+
 void timed_thread_pool::schedule_at(time_point_t deadline, task_base* task)
 {
     std::unique_lock lock {_mtx};
@@ -45,6 +60,17 @@ void timed_thread_pool::stop()
     thread_pool_impl::join();
 }
 
+pool_metrics_snapshot timed_thread_pool::metrics()
+{
+    auto s = thread_pool_impl::metrics();
+
+    if constexpr (metrics_enabled) {
+        s.timer_lateness = _timer_lateness.snapshot();
+    }
+
+    return s;
+}
+
 bool timed_thread_pool::has_expired_task(time_point_t deadline) const
 {
     return !_scheduled_tasks.empty()
@@ -66,16 +92,32 @@ void timed_thread_pool::dispatcher()
 
         auto const now = ++clock_t::now();
 
+        // the timers that expired together are queued at once
+        task_base* first = nullptr;
+        task_base* last = nullptr;
+
         while (has_expired_task(now)) {
-            task_base* task = _scheduled_tasks.top().first;
+            auto const [task, task_deadline] = _scheduled_tasks.top();
             _scheduled_tasks.pop();
             if (!task) {
                 continue;
             }
-            _queue.enqueue_hi(task);
+
+            if constexpr (metrics_enabled) {
+                _timer_lateness.record(now - task_deadline);
+            }
+
+            (last ? last->_next : first) = task;
+            last = task;
+        }
+
+        if (first) {
+            _queue.enqueue_hi_batch(first, last);
         }
     }
 
+    std::unique_lock lock {_mtx};
+
     while (!_scheduled_tasks.empty()) {
         task_base* task = _scheduled_tasks.top().first;
         _scheduled_tasks.pop();
@@ -0,0 +1,179 @@
+#include <execution/trace.hpp>
+
+#include <algorithm>
+#include <array>
+#include <ostream>
+
+namespace execution {
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::atomic<std::uint64_t> next_log_id = 1;
+std::atomic<std::uint32_t> next_tid = 1;
+
+std::uint32_t current_tid() noexcept
+{
+    thread_local std::uint32_t const tid = next_tid.fetch_add(1);
+    return tid;
+}
+
+void write_escaped(std::ostream& os, char const* str)
+{
+    for (; *str; ++str) {
+        if (*str == '"' || *str == '\\') {
+            os << '\\';
+        }
+        os << *str;
+    }
+}
+
+}   // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+trace_log::trace_log(std::size_t capacity_per_thread)
+    : _log_id{next_log_id.fetch_add(1)}
+    , _capacity{std::max<std::size_t>(capacity_per_thread, 1)}
+    , _epoch{clock_t::now()}
+{}
+
+void trace_log::emit(char phase, char const* name, std::uint64_t id) noexcept
+{
+    auto const now = clock_t::now();
+
+    // the event is dropped when the ring can't be allocated
+    ring* r = local_ring();
+    if (!r) {
+        return;
+    }
+
+    auto const head = r->_head.load(std::memory_order_relaxed);
+
+    r->_events[head % _capacity] = trace_event {
+        ._name = name,
+        ._id = id,
+        ._timestamp = static_cast<std::uint64_t>(
+            std::chrono::nanoseconds{now - _epoch}.count()),
+        ._tid = r->_tid,
+        ._phase = phase
+    };
+
+    r->_head.store(head + 1, std::memory_order_release);
+}
+
+std::vector<trace_event> trace_log::events()
+{
+    std::vector<trace_event> result;
+
+    {
+        std::unique_lock lock {_mtx};
+
+        for (auto const& r: _rings) {
+            auto const head = r->_head.load(std::memory_order_acquire);
+            auto const first = head > _capacity ? head - _capacity : 0;
+
+            for (auto i = first; i != head; ++i) {
+                result.push_back(r->_events[i % _capacity]);
+            }
+        }
+    }
+
+    std::stable_sort(result.begin(), result.end(), [] (auto& lhs, auto& rhs) {
+        return lhs._timestamp < rhs._timestamp;
+    });
+
+    return result;
+}
+
+void trace_log::write_chrome_json(std::ostream& os)
+{
+    os << "{\"traceEvents\":[";
+
+    bool first = true;
+    for (auto const& e: events()) {
+        os << (first ? "\n" : ",\n");
+        first = false;
+
+        os << "{\"name\":\"";
+        write_escaped(os, e._name);
+        os << "\",\"cat\":\"execution\",\"ph\":\"" << e._phase
+            << "\",\"ts\":" << e._timestamp / 1000
+            << '.' << e._timestamp / 100 % 10 << e._timestamp / 10 % 10
+            << e._timestamp % 10
+            << ",\"pid\":1,\"tid\":" << e._tid;
+
+        switch (e._phase) {
+        case 'b':
+        case 'e':
+        case 's':
+            os << ",\"id\":\"0x" << std::hex << e._id << std::dec << '"';
+            break;
+        case 'f':
+            os << ",\"id\":\"0x" << std::hex << e._id << std::dec
+                << "\",\"bp\":\"e\"";
+            break;
+        }
+
+        os << '}';
+    }
+
+    os << "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
+
+// the rings of the last few logs the thread emitted to, so that a thread
+// that alternates between logs doesn't take their locks. Log ids aren't
+// reused: the entry of a destroyed log never matches again
+trace_log::ring* trace_log::local_ring() noexcept
+{
+    struct entry
+    {
+        std::uint64_t _log_id = 0;
+        ring* _ring = nullptr;
+    };
+
+    thread_local std::array<entry, 8> cache;
+    thread_local std::size_t next_slot = 0;
+
+    for (auto const& e: cache) {
+        if (e._log_id == _log_id) {
+            return e._ring;
+        }
+    }
+
+    auto* r = register_thread();
+
+    if (r) {
+        cache[next_slot++ % cache.size()] = {_log_id, r};
+    }
+
+    return r;
+}
+
+// nullptr when the ring can't be allocated
+trace_log::ring* trace_log::register_thread() noexcept
+{
+    try {
+        std::unique_lock lock {_mtx};
+
+        auto const thread = std::this_thread::get_id();
+
+        for (auto& r: _rings) {
+            if (r->_thread == thread) {
+                return r.get();
+            }
+        }
+
+        auto r = std::make_unique<ring>();
+        r->_thread = thread;
+        r->_tid = current_tid();
+        r->_events = std::make_unique<trace_event[]>(_capacity);
+
+        return _rings.emplace_back(std::move(r)).get();
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+}   // namespace execution
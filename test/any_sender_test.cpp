@@ -0,0 +1,202 @@
+#include <execution/any_sender.hpp>
+
+#include <execution/just.hpp>
+#include <execution/just_stopped.hpp>
+#include <execution/let_value.hpp>
+#include <execution/null_receiver.hpp>
+#include <execution/schedule.hpp>
+#include <execution/sync_wait.hpp>
+#include <execution/then.hpp>
+#include <execution/thread_pool.hpp>
+#include <execution/when_all.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <stdexcept>
+#include <stop_token>
+#include <string>
+#include <system_error>
+#include <thread>
+
+using namespace execution;
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// completes with an error other than std::exception_ptr
+struct failing
+{
+    using values_t = meta::list<signature<int>>;
+    using errors_t = meta::list<std::error_code>;
+
+    template <typename R>
+    struct operation
+    {
+        R _receiver;
+
+        void start() & noexcept
+        {
+            execution::set_error(
+                std::move(_receiver),
+                std::make_error_code(std::errc::timed_out));
+        }
+    };
+
+    template <typename R>
+    using operation_t = operation<std::decay_t<R>>;
+
+    template <typename R>
+    auto connect(R&& receiver) -> operation_t<R>
+    {
+        return {std::forward<R>(receiver)};
+    }
+};
+
+}   // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST(any_sender, traits)
+{
+    using sender_t = any_sender_of<signature<int>, signature<>>;
+
+    constexpr auto receiver_type = meta::atom<null_receiver>{};
+
+    static_assert(traits::sender_values(meta::atom<sender_t>{}, receiver_type)
+        == meta::list<signature<int>, signature<>>{});
+
+    static_assert(traits::sender_errors(meta::atom<sender_t>{}, receiver_type)
+        == meta::list<std::exception_ptr>{});
+
+    static_assert(std::is_nothrow_move_constructible_v<sender_t>);
+}
+
+TEST(any_sender, value)
+{
+    any_sender_of<signature<int>> s = just(20) | then([] (int x) { return x + 22; });
+
+    auto [r] = *this_thread::sync_wait(std::move(s));
+    EXPECT_EQ(42, r);
+}
+
+TEST(any_sender, dispatch_table)
+{
+    using sender_t = any_sender_of<signature<std::string>>;
+
+    std::map<std::string, std::function<sender_t(int)>> commands;
+
+    commands["hex"] = [] (int x) -> sender_t {
+        return just(x) | then([] (int v) {
+            char buf[16];
+            std::snprintf(buf, sizeof(buf), "%x", v);
+            return std::string{buf};
+        });
+    };
+
+    commands["dec"] = [] (int x) -> sender_t {
+        return just(std::to_string(x));
+    };
+
+    auto [hex] = *this_thread::sync_wait(commands["hex"](255));
+    auto [dec] = *this_thread::sync_wait(commands["dec"](255));
+
+    EXPECT_EQ("ff", hex);
+    EXPECT_EQ("255", dec);
+}
+
+TEST(any_sender, large_state)
+{
+    std::array<int, 64> data {};
+    data[63] = 42;
+
+    any_sender_of<signature<int>> s = just(data)
+        | then([] (auto const& d) { return d[63]; });
+
+    auto [r] = *this_thread::sync_wait(std::move(s));
+    EXPECT_EQ(42, r);
+}
+
+TEST(any_sender, error)
+{
+    any_sender_of<signature<int>> s = just(1)
+        | then([] (int) -> int { throw std::runtime_error{"error"}; });
+
+    EXPECT_THROW(this_thread::sync_wait(std::move(s)), std::runtime_error);
+}
+
+TEST(any_sender, error_code)
+{
+    any_sender_of<signature<int>> s = failing{};
+
+    EXPECT_THROW(this_thread::sync_wait(std::move(s)), std::system_error);
+}
+
+TEST(any_sender, stopped)
+{
+    any_sender_of<signature<int>> s = just_stopped();
+
+    EXPECT_FALSE(this_thread::sync_wait(std::move(s)).has_value());
+}
+
+TEST(any_sender, move)
+{
+    any_sender_of<signature<int>> s0 = just(1);
+    any_sender_of<signature<int>> s1 = just(2);
+
+    s1 = std::move(s0);
+
+    auto [r] = *this_thread::sync_wait(std::move(s1));
+    EXPECT_EQ(1, r);
+}
+
+TEST(any_sender, composition)
+{
+    auto s0 = when_all(
+        any_sender_of<signature<int>>{just(1)},
+        any_sender_of<signature<int>>{just(2) | then([] (int x) { return x * 10; })});
+
+    auto [x, y] = *this_thread::sync_wait(std::move(s0));
+    EXPECT_EQ(1, x);
+    EXPECT_EQ(20, y);
+
+    auto s1 = just(1, 20)
+        | let_value([] (int x, int y) -> any_sender_of<signature<int>> {
+            return just(x + y);
+        });
+
+    auto [r] = *this_thread::sync_wait(std::move(s1));
+    EXPECT_EQ(21, r);
+}
+
+TEST(any_sender, stop_token)
+{
+    thread_pool pool {1};
+
+    std::stop_source stop_source;
+    stop_source.request_stop();
+
+    // the pool completes with set_stopped on a stop request
+    any_sender_of<signature<>> s = schedule(pool.get_scheduler());
+
+    auto r = this_thread::sync_wait(std::move(s), stop_source);
+
+    EXPECT_FALSE(r.has_value());
+}
+
+TEST(any_sender, thread_pool)
+{
+    thread_pool pool {1};
+
+    any_sender_of<signature<bool>> s = schedule(pool.get_scheduler())
+        | then([id = std::this_thread::get_id()] {
+            return id != std::this_thread::get_id();
+        });
+
+    auto [r] = *this_thread::sync_wait(std::move(s));
+    EXPECT_TRUE(r);
+}
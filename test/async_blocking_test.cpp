@@ -0,0 +1,96 @@
+#include <execution/async_blocking.hpp>
+
+#include <execution/null_receiver.hpp>
+#include <execution/start_detached.hpp>
+#include <execution/sync_wait.hpp>
+#include <execution/then.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace execution;
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST(async_blocking, traits)
+{
+    constexpr auto receiver_type = meta::atom<null_receiver>{};
+
+    constexpr auto s0_type = meta::atom<decltype(async_blocking([] {}))>{};
+    constexpr auto s1_type = meta::atom<decltype(async_blocking([] { return std::string{}; }))>{};
+
+    static_assert(traits::sender_values(s0_type, receiver_type)
+        == meta::list<signature<>>{});
+    static_assert(traits::sender_values(s1_type, receiver_type)
+        == meta::list<signature<std::string>>{});
+
+    static_assert(traits::sender_errors(s1_type, receiver_type)
+        == meta::list<std::exception_ptr>{});
+}
+
+TEST(async_blocking, transfer_back)
+{
+    auto const main_tid = std::this_thread::get_id();
+
+    std::thread::id blocking_tid;
+
+    // sync_wait completes on its run loop, on this thread
+    auto [result] = *this_thread::sync_wait(
+        async_blocking([&] {
+            blocking_tid = std::this_thread::get_id();
+            return 42;
+        })
+        | then([] (int v) {
+            return std::tuple{v, std::this_thread::get_id()};
+        }));
+
+    auto const& [r, completion_tid] = result;
+
+    EXPECT_EQ(42, r);
+    EXPECT_NE(main_tid, blocking_tid);
+    EXPECT_EQ(main_tid, completion_tid);
+}
+
+TEST(async_blocking, error)
+{
+    EXPECT_THROW(
+        this_thread::sync_wait(async_blocking([] { throw std::runtime_error{"42"}; })),
+        std::runtime_error);
+}
+
+TEST(async_blocking, concurrent)
+{
+    constexpr int count = 4;
+
+    std::promise<void> gate;
+    auto opened = gate.get_future().share();
+
+    std::atomic<int> started = 0;
+    std::atomic<int> done = 0;
+    std::promise<void> all_done;
+
+    // each call blocks until all of them run, which needs a worker for each
+    for (int i = 0; i != count; ++i) {
+        start_detached(
+            async_blocking([&, opened] {
+                if (++started == count) {
+                    gate.set_value();
+                }
+                opened.wait();
+            })
+            | then([&] {
+                if (++done == count) {
+                    all_done.set_value();
+                }
+            }));
+    }
+
+    all_done.get_future().wait();
+
+    EXPECT_LE(static_cast<std::size_t>(count), blocking_pool().size());
+}
@@ -4,11 +4,15 @@
 #include <execution/null_receiver.hpp>
 #include <execution/schedule.hpp>
 #include <execution/thread_pool.hpp>
+#include <execution/start_detached.hpp>
 #include <execution/sync_wait.hpp>
+#include <execution/then.hpp>
 #include <execution/transfer_just.hpp>
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <future>
 #include <string>
 #include <vector>
 
@@ -92,3 +96,42 @@ TEST(bulk, threads)
     EXPECT_NE(main_tid, ids[0]);
     EXPECT_NE(main_tid, ids[1]);
 }
+
+TEST(bulk, request_stop)
+{
+    thread_pool pool {1};
+
+    auto sched = pool.get_scheduler();
+
+    // keeps the only worker busy while the chunks are queued
+    std::promise<void> gate;
+    std::promise<void> busy;
+    auto opened = gate.get_future().share();
+
+    start_detached(schedule(sched) | then([opened, &busy] {
+        busy.set_value();
+        opened.wait();
+    }));
+
+    busy.get_future().wait();
+
+    std::atomic<int> calls = 0;
+    std::promise<void> started;
+
+    // the source completes on the waiting thread, so only the chunks go
+    // through the queue
+    auto stopped = std::async(std::launch::async, [&] {
+        auto source = just() | then([&] { started.set_value(); });
+
+        return !this_thread::sync_wait(execution::tag_invoke(
+            bulk, sched, std::move(source), 4, [&] (int) { ++calls; }));
+    });
+
+    started.get_future().wait();
+
+    pool.request_stop();
+    gate.set_value();
+
+    EXPECT_TRUE(stopped.get());
+    EXPECT_EQ(0, calls);
+}
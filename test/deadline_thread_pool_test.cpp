@@ -0,0 +1,229 @@
+#include <execution/deadline_thread_pool.hpp>
+#include <execution/with_deadline.hpp>
+
+#include <execution/just.hpp>
+#include <execution/schedule.hpp>
+#include <execution/start_detached.hpp>
+#include <execution/sync_wait.hpp>
+#include <execution/then.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+using namespace execution;
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// completes with the deadline of its receiver
+struct read_deadline
+{
+    template <typename R>
+    struct operation
+    {
+        R _receiver;
+
+        void start() & noexcept
+        {
+            execution::set_value(std::move(_receiver), execution::get_deadline(_receiver));
+        }
+    };
+
+    template <typename R>
+    auto connect(R&& receiver) const
+    {
+        return operation<std::decay_t<R>>{std::forward<R>(receiver)};
+    }
+};
+
+}   // namespace
+
+template <typename R>
+struct execution::sender_traits<read_deadline, R>
+{
+    using operation_t = read_deadline::operation<std::decay_t<R>>;
+    using values_t = meta::list<signature<deadline_t>>;
+    using errors_t = meta::list<>;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST(with_deadline, get_deadline)
+{
+    auto const tp = deadline_clock_t::now() + 1h;
+
+    auto [none] = *this_thread::sync_wait(read_deadline{});
+    EXPECT_EQ(no_deadline, none);
+
+    auto [fixed] = *this_thread::sync_wait(read_deadline{} | with_deadline(tp));
+    EXPECT_EQ(tp, fixed);
+
+    // the earlier one wins
+    auto [outer] = *this_thread::sync_wait(
+        with_deadline(read_deadline{}, tp + 1h) | with_deadline(tp));
+    EXPECT_EQ(tp, outer);
+
+    auto const before = deadline_clock_t::now();
+    auto [budget] = *this_thread::sync_wait(read_deadline{} | with_deadline(10s));
+    EXPECT_LE(before + 10s, budget);
+    EXPECT_GE(deadline_clock_t::now() + 10s, budget);
+}
+
+TEST(deadline_task_queue, order)
+{
+    deadline_task_queue queue;
+
+    auto const now = deadline_clock_t::now();
+
+    deadline_task tasks[4];
+    task_base background;
+
+    queue.enqueue(&background);
+    queue.enqueue(now + 3h, &tasks[0]);
+    queue.enqueue(now + 1h, &tasks[1]);
+    queue.enqueue(now + 2h, &tasks[2]);
+    queue.enqueue(now + 1h, &tasks[3]);
+
+    EXPECT_EQ(&tasks[1], queue.try_dequeue());
+    EXPECT_EQ(&tasks[3], queue.try_dequeue());
+    EXPECT_EQ(&tasks[2], queue.try_dequeue());
+    EXPECT_EQ(&tasks[0], queue.try_dequeue());
+    EXPECT_EQ(&background, queue.try_dequeue());
+    EXPECT_EQ(nullptr, queue.try_dequeue());
+
+    EXPECT_EQ(0u, queue.late_count());
+}
+
+TEST(deadline_task_queue, late)
+{
+    deadline_task_queue queue;
+
+    deadline_task late;
+    deadline_task early;
+
+    queue.enqueue(deadline_clock_t::now() - 1ms, &late);
+    queue.enqueue(deadline_clock_t::now() + 1h, &early);
+
+    EXPECT_EQ(&late, queue.try_dequeue());
+    EXPECT_TRUE(late._late);
+
+    EXPECT_EQ(&early, queue.try_dequeue());
+    EXPECT_FALSE(early._late);
+
+    EXPECT_EQ(1u, queue.late_count());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST(deadline_thread_pool, earliest_first)
+{
+    deadline_thread_pool pool {1};
+
+    auto sched = pool.get_scheduler();
+
+    // keeps the only worker busy while the others are queued
+    std::promise<void> gate;
+    std::promise<void> busy;
+    auto opened = gate.get_future().share();
+
+    start_detached(schedule(sched) | then([opened, &busy] {
+        busy.set_value();
+        opened.wait();
+    }));
+
+    busy.get_future().wait();
+
+    std::mutex mtx;
+    std::vector<int> order;
+    std::promise<void> done;
+
+    auto const now = deadline_clock_t::now();
+
+    for (int i: {3, 0, 1, 2}) {
+        auto const deadline = i ? now + i * 1h : no_deadline;
+
+        start_detached(
+            schedule(sched)
+                | then([&, i] {
+                    std::unique_lock lock {mtx};
+                    order.push_back(i);
+                    if (order.size() == 4) {
+                        done.set_value();
+                    }
+                })
+                | with_deadline(deadline));
+    }
+
+    gate.set_value();
+    done.get_future().wait();
+
+    EXPECT_EQ((std::vector{1, 2, 3, 0}), order);
+    EXPECT_EQ(0u, pool.late_count());
+}
+
+TEST(deadline_thread_pool, late)
+{
+    for (auto policy: {late_policy::run, late_policy::shed}) {
+        deadline_thread_pool pool {
+            thread_pool_options{.worker_count = 1},
+            deadline_options{.policy = policy}
+        };
+
+        auto r = this_thread::sync_wait(
+            schedule(pool.get_scheduler())
+                | then([] { return 42; })
+                | with_deadline(deadline_clock_t::now() - 1ms));
+
+        EXPECT_EQ(policy == late_policy::run, r.has_value());
+        EXPECT_EQ(1u, pool.late_count());
+        EXPECT_EQ(policy == late_policy::shed ? 1u : 0u, pool.shed_count());
+    }
+}
+
+TEST(deadline_thread_pool, stop)
+{
+    deadline_thread_pool pool {1};
+
+    auto sched = pool.get_scheduler();
+
+    std::promise<void> gate;
+    std::promise<void> busy;
+    auto opened = gate.get_future().share();
+
+    start_detached(schedule(sched) | then([opened, &busy] {
+        busy.set_value();
+        opened.wait();
+    }));
+
+    busy.get_future().wait();
+
+    // each task schedules the next one, without a deadline, while the pool
+    // is stopping: all of them run
+    std::atomic<int> ran = 0;
+    std::function<void()> next = [&] {
+        if (++ran < 10) {
+            start_detached(schedule(sched) | then(next));
+        }
+    };
+
+    start_detached(schedule(sched) | then(next));
+
+    auto stopped = std::async(std::launch::async, [&] {
+        pool.stop();
+    });
+
+    std::this_thread::sleep_for(10ms);
+    gate.set_value();
+    stopped.wait();
+
+    EXPECT_EQ(10, ran);
+}
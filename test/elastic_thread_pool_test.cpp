@@ -0,0 +1,207 @@
+#include <execution/elastic_thread_pool.hpp>
+
+#include <execution/schedule.hpp>
+#include <execution/start_detached.hpp>
+#include <execution/sync_wait.hpp>
+#include <execution/then.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <thread>
+
+using namespace std::chrono_literals;
+using namespace execution;
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// polls `pred` for up to 5s
+template <typename F>
+bool eventually(F&& pred)
+{
+    auto const deadline = std::chrono::steady_clock::now() + 5s;
+
+    while (!pred()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(1ms);
+    }
+
+    return true;
+}
+
+}   // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST(elastic_thread_pool, schedule)
+{
+    elastic_thread_pool pool {1, 4};
+
+    EXPECT_EQ(1u, pool.size());
+    EXPECT_EQ(1u, pool.min_workers());
+    EXPECT_EQ(4u, pool.max_workers());
+
+    auto [r] = *this_thread::sync_wait(
+        schedule(pool.get_scheduler()) | then([] { return 42; }));
+
+    EXPECT_EQ(42, r);
+}
+
+TEST(elastic_thread_pool, no_minimum)
+{
+    elastic_thread_pool pool {
+        thread_pool_options{.worker_count = 0},
+        elastic_options{.max_workers = 2, .idle_timeout = 10ms}
+    };
+
+    EXPECT_EQ(0u, pool.size());
+
+    auto [r] = *this_thread::sync_wait(
+        schedule(pool.get_scheduler()) | then([] { return 42; }));
+
+    EXPECT_EQ(42, r);
+    EXPECT_TRUE(eventually([&] { return pool.size() == 0; }));
+}
+
+TEST(elastic_thread_pool, grow_and_shrink)
+{
+    elastic_thread_pool pool {
+        thread_pool_options{.worker_count = 1},
+        elastic_options{.max_workers = 4, .grow_after = 1ms, .idle_timeout = 20ms}
+    };
+
+    auto sched = pool.get_scheduler();
+
+    std::promise<void> gate;
+    auto opened = gate.get_future().share();
+    std::atomic<int> started = 0;
+
+    for (int i = 0; i != 6; ++i) {
+        start_detached(schedule(sched) | then([opened, &started] {
+            ++started;
+            opened.wait();
+        }));
+    }
+
+    // nothing else is scheduled: the monitor sees the backlog
+    EXPECT_TRUE(eventually([&] { return started == 4; }));
+
+    std::this_thread::sleep_for(10ms);
+
+    EXPECT_EQ(4u, pool.size());
+    EXPECT_EQ(4, started);
+
+    gate.set_value();
+
+    EXPECT_TRUE(eventually([&] { return started == 6; }));
+    EXPECT_TRUE(eventually([&] { return pool.size() == 1; }));
+}
+
+TEST(elastic_thread_pool, blocking_region)
+{
+    elastic_thread_pool pool {
+        thread_pool_options{.worker_count = 1},
+        elastic_options{.max_workers = 1, .grow_after = 1h, .idle_timeout = 20ms}
+    };
+
+    // nothing to compensate off the pool
+    {
+        elastic_thread_pool::blocking_region region;
+        EXPECT_EQ(0u, pool.blocked());
+    }
+
+    std::promise<void> gate;
+    std::promise<void> busy;
+    auto opened = gate.get_future().share();
+
+    start_detached(schedule(pool.get_scheduler()) | then([opened, &busy] {
+        elastic_thread_pool::blocking_region region;
+        busy.set_value();
+        opened.wait();
+    }));
+
+    busy.get_future().wait();
+
+    EXPECT_EQ(1u, pool.blocked());
+    EXPECT_EQ(2u, pool.size());
+
+    // runs on the compensating worker, beyond max_workers
+    auto [r] = *this_thread::sync_wait(
+        schedule(pool.get_scheduler()) | then([] { return 42; }));
+
+    EXPECT_EQ(42, r);
+
+    gate.set_value();
+
+    EXPECT_TRUE(eventually([&] { return pool.blocked() == 0; }));
+    EXPECT_TRUE(eventually([&] { return pool.size() == 1; }));
+}
+
+TEST(elastic_thread_pool, stop)
+{
+    elastic_thread_pool pool {2, 2};
+
+    auto sched = pool.get_scheduler();
+
+    std::promise<void> gate;
+    std::promise<void> busy;
+    auto opened = gate.get_future().share();
+
+    start_detached(schedule(sched) | then([opened, &busy] {
+        busy.set_value();
+        opened.wait();
+    }));
+
+    busy.get_future().wait();
+
+    // each task schedules the next one while the pool is stopping
+    std::atomic<int> ran = 0;
+    std::function<void()> next = [&] {
+        if (++ran < 10) {
+            start_detached(schedule(sched) | then(next));
+        }
+    };
+
+    start_detached(schedule(sched) | then(next));
+
+    auto stopped = std::async(std::launch::async, [&] {
+        pool.stop();
+    });
+
+    std::this_thread::sleep_for(10ms);
+    gate.set_value();
+    stopped.wait();
+
+    EXPECT_EQ(10, ran);
+    EXPECT_EQ(0u, pool.size());
+
+    // once the workers are gone, on the calling thread
+    auto const caller = std::this_thread::get_id();
+    auto [id] = *this_thread::sync_wait(schedule(sched) | then([] {
+        return std::this_thread::get_id();
+    }));
+
+    EXPECT_EQ(caller, id);
+}
+
+TEST(elastic_thread_pool, stop_without_workers)
+{
+    elastic_thread_pool pool {
+        thread_pool_options{.worker_count = 0},
+        elastic_options{.max_workers = 1}
+    };
+
+    pool.stop();
+
+    auto [r] = *this_thread::sync_wait(
+        schedule(pool.get_scheduler()) | then([] { return 42; }));
+
+    EXPECT_EQ(42, r);
+}
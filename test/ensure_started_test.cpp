@@ -11,6 +11,8 @@
 
 #include <gtest/gtest.h>
 
+#include <future>
+
 using namespace std::chrono_literals;
 
 using namespace execution;
@@ -0,0 +1,124 @@
+#include <execution/fair_queue.hpp>
+#include <execution/thread_pool.hpp>
+
+#include <execution/schedule.hpp>
+#include <execution/start_detached.hpp>
+#include <execution/sync_wait.hpp>
+#include <execution/then.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <future>
+#include <mutex>
+#include <vector>
+
+using namespace execution;
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// runs `counts[t]` tasks of every tenant t on a single worker, all queued
+// before the first one runs, and returns the tenants in execution order
+std::vector<int> run_order(
+    fair_queue<thread_pool>& fair,
+    thread_pool& pool,
+    std::vector<int> const& counts)
+{
+    std::promise<void> gate;
+    std::promise<void> busy;
+    auto opened = gate.get_future().share();
+
+    start_detached(schedule(pool.get_scheduler()) | then([opened, &busy] {
+        busy.set_value();
+        opened.wait();
+    }));
+
+    busy.get_future().wait();
+
+    std::mutex mtx;
+    std::vector<int> order;
+    std::promise<void> done;
+
+    int total = 0;
+    for (int c: counts) {
+        total += c;
+    }
+
+    for (int t = 0; t != static_cast<int>(counts.size()); ++t) {
+        auto sched = fair.get_scheduler(t);
+
+        for (int i = 0; i != counts[t]; ++i) {
+            start_detached(schedule(sched) | then([&, t] {
+                std::unique_lock lock {mtx};
+                order.push_back(t);
+                if (static_cast<int>(order.size()) == total) {
+                    done.set_value();
+                }
+            }));
+        }
+    }
+
+    gate.set_value();
+    done.get_future().wait();
+
+    return order;
+}
+
+}   // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST(fair_queue, schedule)
+{
+    thread_pool pool {2};
+    fair_queue fair {pool, 2};
+
+    auto [r] = *this_thread::sync_wait(
+        schedule(fair.get_scheduler(7)) | then([] { return 42; }));
+
+    EXPECT_EQ(42, r);
+    EXPECT_EQ(0u, fair.size(7));
+}
+
+TEST(fair_queue, flood)
+{
+    thread_pool pool {1};
+    fair_queue fair {pool, 1};
+
+    // tenant 0 floods the queue before tenant 1 shows up
+    auto const order = run_order(fair, pool, {100, 10});
+
+    ASSERT_EQ(110u, order.size());
+
+    auto const last = std::find(order.rbegin(), order.rend(), 1);
+    EXPECT_GE(20, order.rend() - last);
+}
+
+TEST(fair_queue, weights)
+{
+    thread_pool pool {1};
+    fair_queue fair {pool, 1};
+
+    fair.set_weight(0, 3);
+
+    auto const order = run_order(fair, pool, {40, 40});
+
+    ASSERT_EQ(80u, order.size());
+
+    auto const first = std::vector<int>(order.begin(), order.begin() + 16);
+    EXPECT_EQ(12, std::count(first.begin(), first.end(), 0));
+    EXPECT_EQ(4, std::count(first.begin(), first.end(), 1));
+}
+
+TEST(fair_queue, request_stop)
+{
+    thread_pool pool {1};
+    fair_queue fair {pool, 1};
+
+    pool.request_stop();
+    EXPECT_TRUE(fair.stop_requested());
+
+    EXPECT_FALSE(this_thread::sync_wait(schedule(fair.get_scheduler(0))));
+}
@@ -0,0 +1,237 @@
+#include <execution/get_allocator.hpp>
+
+#include <execution/ensure_started.hpp>
+#include <execution/just.hpp>
+#include <execution/let_value.hpp>
+#include <execution/null_receiver.hpp>
+#include <execution/start_detached.hpp>
+#include <execution/sync_wait.hpp>
+#include <execution/then.hpp>
+#include <execution/when_all_range.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+using namespace execution;
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct allocation_stats
+{
+    int _allocations = 0;
+    int _deallocations = 0;
+};
+
+template <typename T>
+struct counting_allocator
+{
+    using value_type = T;
+
+    allocation_stats* _stats;
+
+    explicit counting_allocator(allocation_stats* stats) noexcept
+        : _stats{stats}
+    {}
+
+    template <typename U>
+    counting_allocator(counting_allocator<U> const& other) noexcept
+        : _stats{other._stats}
+    {}
+
+    T* allocate(std::size_t n)
+    {
+        ++_stats->_allocations;
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept
+    {
+        ++_stats->_deallocations;
+        std::allocator<T>{}.deallocate(p, n);
+    }
+
+    template <typename U>
+    bool operator == (counting_allocator<U> const& other) const noexcept
+    {
+        return _stats == other._stats;
+    }
+};
+
+template <typename R>
+struct allocator_receiver
+{
+    R _receiver;
+    counting_allocator<std::byte> _allocator;
+
+    template <typename ... Ts>
+    void set_value(Ts&& ... values)
+    {
+        execution::set_value(std::move(_receiver), std::forward<Ts>(values)...);
+    }
+
+    template <typename E>
+    void set_error(E&& error)
+    {
+        execution::set_error(std::move(_receiver), std::forward<E>(error));
+    }
+
+    void set_stopped()
+    {
+        execution::set_stopped(std::move(_receiver));
+    }
+
+    friend auto tag_invoke(tag_t<get_allocator>, const allocator_receiver& self) noexcept
+    {
+        return self._allocator;
+    }
+
+    template <typename Tag, typename ... Ts>
+    friend auto tag_invoke(Tag tag, const allocator_receiver& self, Ts&& ... args)
+        noexcept(is_nothrow_tag_invocable_v<Tag, R, Ts...>)
+        -> tag_invoke_result_t<Tag, R, Ts...>
+    {
+        return tag(self._receiver, std::forward<Ts>(args)...);
+    }
+};
+
+// completes the wrapped sender on a receiver answering get_allocator
+template <typename S>
+struct with_allocator
+{
+    S _source;
+    counting_allocator<std::byte> _allocator;
+
+    template <typename R>
+    auto connect(R&& receiver) &&
+    {
+        return execution::connect(
+            std::move(_source),
+            allocator_receiver<std::decay_t<R>>{
+                std::forward<R>(receiver),
+                _allocator
+            });
+    }
+};
+
+// reports the allocator it sees in the receiver environment
+struct query_sender
+{
+    allocation_stats** _seen;
+
+    using values_t = meta::list<signature<>>;
+    using errors_t = meta::list<>;
+
+    template <typename R>
+    struct operation
+    {
+        R _receiver;
+        allocation_stats** _seen;
+
+        void start() & noexcept
+        {
+            *_seen = execution::get_allocator(_receiver)._stats;
+            execution::set_value(std::move(_receiver));
+        }
+    };
+
+    template <typename R>
+    using operation_t = operation<std::decay_t<R>>;
+
+    template <typename R>
+    auto connect(R&& receiver) -> operation<std::decay_t<R>>
+    {
+        return {std::forward<R>(receiver), _seen};
+    }
+};
+
+}   // namespace
+
+template <typename S, typename R>
+struct execution::sender_traits<with_allocator<S>, R>
+{
+    static constexpr auto source_type = meta::atom<S>{};
+    static constexpr auto receiver_type = meta::atom<allocator_receiver<R>>{};
+
+    using operation_t = typename decltype(traits::sender_operation(
+        source_type, receiver_type))::type;
+    using values_t = decltype(traits::sender_values(source_type, receiver_type));
+    using errors_t = decltype(traits::sender_errors(source_type, receiver_type));
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST(get_allocator, default)
+{
+    static_assert(std::is_same_v<
+        std::allocator<std::byte>,
+        allocator_of_t<null_receiver>>);
+}
+
+TEST(get_allocator, forwarded)
+{
+    allocation_stats stats;
+    counting_allocator<std::byte> allocator {&stats};
+
+    allocation_stats* seen = nullptr;
+
+    auto r = this_thread::sync_wait(with_allocator{
+        just()
+            | let_value([&] { return query_sender{&seen}; })
+            | then([] { return 1; }),
+        allocator
+    });
+
+    EXPECT_TRUE(r.has_value());
+    EXPECT_EQ(&stats, seen);
+}
+
+TEST(get_allocator, when_all_range)
+{
+    allocation_stats stats;
+    counting_allocator<std::byte> allocator {&stats};
+
+    auto [r] = *this_thread::sync_wait(with_allocator{
+        when_all_range(std::vector{just(1), just(2), just(3)}),
+        allocator
+    });
+
+    EXPECT_EQ((std::vector{1, 2, 3}), r);
+    EXPECT_EQ(1, stats._allocations);
+    EXPECT_EQ(1, stats._deallocations);
+}
+
+TEST(get_allocator, start_detached)
+{
+    allocation_stats stats;
+    counting_allocator<std::byte> allocator {&stats};
+
+    int value = 0;
+
+    start_detached(just(42) | then([&] (int x) { value = x; }), allocator);
+
+    EXPECT_EQ(42, value);
+    EXPECT_EQ(1, stats._allocations);
+    EXPECT_EQ(1, stats._deallocations);
+}
+
+TEST(get_allocator, ensure_started)
+{
+    allocation_stats stats;
+    counting_allocator<std::byte> allocator {&stats};
+
+    {
+        auto s = ensure_started(just(42), allocator);
+
+        EXPECT_EQ(2, stats._allocations);
+
+        auto [r] = *this_thread::sync_wait(std::move(s));
+        EXPECT_EQ(42, r);
+    }
+
+    EXPECT_EQ(2, stats._deallocations);
+}
@@ -0,0 +1,134 @@
+#include <execution/inplace_stop_token.hpp>
+
+#include <execution/null_receiver.hpp>
+#include <execution/stop_token.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <optional>
+#include <thread>
+
+using namespace execution;
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST(inplace_stop_token, simple)
+{
+    inplace_stop_source ss;
+
+    auto token = ss.get_token();
+
+    EXPECT_TRUE(token.stop_possible());
+    EXPECT_FALSE(token.stop_requested());
+    EXPECT_FALSE(inplace_stop_token{}.stop_possible());
+
+    int count = 0;
+
+    inplace_stop_callback cb1 {token, [&] { ++count; }};
+    inplace_stop_callback cb2 {token, [&] { ++count; }};
+
+    EXPECT_TRUE(ss.request_stop());
+    EXPECT_FALSE(ss.request_stop());
+
+    EXPECT_TRUE(token.stop_requested());
+    EXPECT_EQ(2, count);
+
+    // already stopped: invoked inline
+    inplace_stop_callback cb3 {token, [&] { ++count; }};
+
+    EXPECT_EQ(3, count);
+}
+
+TEST(inplace_stop_token, unregister)
+{
+    inplace_stop_source ss;
+
+    int count = 0;
+
+    {
+        inplace_stop_callback cb {ss.get_token(), [&] { ++count; }};
+    }
+
+    ss.request_stop();
+
+    EXPECT_EQ(0, count);
+}
+
+TEST(inplace_stop_token, unregister_during_callback)
+{
+    inplace_stop_source ss;
+
+    using callback_t = inplace_stop_callback<std::function<void()>>;
+
+    std::optional<callback_t> cb;
+    cb.emplace(ss.get_token(), [&] { cb.reset(); });
+
+    ss.request_stop();
+
+    EXPECT_FALSE(cb.has_value());
+}
+
+TEST(inplace_stop_token, threads)
+{
+    using callback_t = inplace_stop_callback<std::function<void()>>;
+
+    constexpr int count = 100;
+
+    for (int i = 0; i != 100; ++i) {
+        inplace_stop_source ss;
+
+        // registered before request_stop and alive through it
+        std::atomic<int> kept_calls = 0;
+        callback_t kept {ss.get_token(), [&] { ++kept_calls; }};
+
+        std::array<std::atomic<int>, count> calls {};
+        // the calls right after registering a callback once the stop was
+        // requested; -1 when registered before
+        std::array<int, count> inline_calls {};
+
+        std::thread t {[&] {
+            for (int j = 0; j != count; ++j) {
+                bool const stopped = ss.stop_requested();
+
+                callback_t cb {ss.get_token(), [&, j] { ++calls[j]; }};
+
+                inline_calls[j] = stopped ? calls[j].load() : -1;
+            }
+        }};
+
+        ss.request_stop();
+        t.join();
+
+        EXPECT_EQ(1, kept_calls.load());
+
+        for (int j = 0; j != count; ++j) {
+            if (inline_calls[j] != -1) {
+                EXPECT_EQ(1, inline_calls[j]);
+            }
+
+            // once, unless unregistered before request_stop got to it
+            EXPECT_GE(1, calls[j].load());
+        }
+    }
+}
+
+TEST(inplace_stop_token, concepts)
+{
+    static_assert(stoppable_token<inplace_stop_token>);
+    static_assert(stoppable_token<never_stop_token>);
+    static_assert(stoppable_token<std::stop_token>);
+
+    static_assert(unstoppable_token<never_stop_token>);
+    static_assert(!unstoppable_token<inplace_stop_token>);
+    static_assert(!unstoppable_token<std::stop_token>);
+
+    static_assert(std::is_same_v<
+        never_stop_token,
+        stop_token_of_t<null_receiver>>);
+
+    static_assert(std::is_empty_v<
+        stop_callback_for_t<never_stop_token, std::function<void()>>>);
+}
@@ -61,3 +61,27 @@ TEST(meta, list)
 
     static_assert(chain(ls) == ls);
 }
+
+TEST(meta, wide)
+{
+    constexpr auto ls = iota<64>;
+
+    static_assert(ls[index_t<63>{}] == atom<int_constant_t<63>>{});
+    static_assert(ls[index_t<-64>{}] == atom<int_constant_t<0>>{});
+    static_assert(find(ls, atom<int_constant_t<42>>{}) == 42);
+    static_assert(contains(ls, atom<int_constant_t<63>>{}));
+    static_assert(!contains(ls, atom<int_constant_t<64>>{}));
+
+    static_assert(unique(ls | ls | ls) == ls);
+
+    // keeps the last occurrence
+    static_assert(unique(list<int, char, int, double, char>{}) == list<int, double, char>{});
+
+    static_assert(transform(list<int, char>{}, [] (auto a) {
+        return a | a;
+    }) == list<int, int, char, char>{});
+
+    static_assert(zip_transform(list<int, char>{}, list<double, float>{}, [] (auto a, auto b) {
+        return b | a;
+    }) == list<double, int, float, char>{});
+}
@@ -0,0 +1,161 @@
+#include <execution/metrics.hpp>
+
+#include <execution/priority_thread_pool.hpp>
+#include <execution/schedule.hpp>
+#include <execution/sync_wait.hpp>
+#include <execution/then.hpp>
+#include <execution/thread_pool.hpp>
+#include <execution/timed_thread_pool.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+using namespace execution;
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST(metrics, histogram)
+{
+    histogram h;
+
+    h.record(0ns);
+    h.record(1ns);
+    h.record(1000ns);
+    h.record(1500ns);
+
+    auto s = h.snapshot();
+
+    EXPECT_EQ(4, s.count);
+    EXPECT_EQ(2501, s.sum);
+    EXPECT_EQ(2, s.buckets[0]);
+    EXPECT_EQ(1, s.buckets[9]);     // [512, 1024)
+    EXPECT_EQ(1, s.buckets[10]);    // [1024, 2048)
+    EXPECT_EQ(625ns, s.mean());
+    EXPECT_EQ(2ns, s.percentile(0.25));
+    EXPECT_EQ(2048ns, s.percentile(1.0));
+}
+
+TEST(metrics, zero_overhead)
+{
+    if (metrics_enabled) {
+        GTEST_SKIP();
+    }
+
+    EXPECT_TRUE(std::is_empty_v<task_timestamp>);
+    EXPECT_TRUE(std::is_empty_v<metrics_histogram>);
+    EXPECT_EQ(sizeof(task_base::execute_t) + sizeof(task_base*),
+        sizeof(task_base));
+}
+
+TEST(metrics, thread_pool)
+{
+    thread_pool pool {2};
+
+    auto sched = pool.get_scheduler();
+
+    for (int i = 0; i != 10; ++i) {
+        this_thread::sync_wait(schedule(sched) | then([] {
+            std::this_thread::sleep_for(1ms);
+        }));
+    }
+
+    // workers account for a task after it returns
+    pool.stop();
+
+    auto s = pool.metrics();
+
+    if constexpr (!metrics_enabled) {
+        EXPECT_TRUE(s.workers.empty());
+        return;
+    }
+
+    ASSERT_EQ(2, s.workers.size());
+    EXPECT_EQ(10, s.workers[0].tasks + s.workers[1].tasks);
+    EXPECT_LE(1ms,
+        s.workers[0].run_time.mean() + s.workers[1].run_time.mean());
+    EXPECT_EQ(0, s.queue_depth);
+}
+
+TEST(metrics, parks)
+{
+    thread_pool pool {
+        thread_pool_options{.worker_count = 1, .spin_limit = 0}
+    };
+
+    auto sched = pool.get_scheduler();
+
+    for (int i = 0; i != 10; ++i) {
+        this_thread::sync_wait(schedule(sched));
+    }
+
+    pool.stop();
+
+    auto s = pool.metrics();
+
+    if constexpr (!metrics_enabled) {
+        EXPECT_TRUE(s.workers.empty());
+        return;
+    }
+
+    // the worker waits at most once for each task and once before it stops
+    ASSERT_EQ(1, s.workers.size());
+    EXPECT_GE(11, s.workers[0].parks);
+}
+
+TEST(metrics, timer_lateness)
+{
+    timed_thread_pool pool {1};
+
+    auto sched = pool.get_scheduler();
+
+    this_thread::sync_wait(schedule_after(sched, 1ms));
+
+    // workers account for a task after it returns
+    pool.stop();
+
+    auto s = pool.metrics();
+
+    if constexpr (!metrics_enabled) {
+        EXPECT_TRUE(s.workers.empty());
+        EXPECT_EQ(0, s.timer_lateness.count);
+        return;
+    }
+
+    ASSERT_EQ(1, s.workers.size());
+    EXPECT_EQ(1, s.workers[0].tasks);
+    EXPECT_EQ(1, s.timer_lateness.count);
+}
+
+TEST(metrics, priority_levels)
+{
+    priority_thread_pool pool {
+        thread_pool_options{.worker_count = 1},
+        priority_options{.levels = 2}
+    };
+
+    auto sched = pool.get_scheduler();
+
+    this_thread::sync_wait(schedule(sched.with_priority(0)));
+    this_thread::sync_wait(schedule(sched.with_priority(1)));
+    this_thread::sync_wait(schedule(sched.with_priority(1)));
+
+    pool.stop();
+
+    auto s = pool.metrics();
+
+    if constexpr (!metrics_enabled) {
+        EXPECT_TRUE(s.levels.empty());
+        return;
+    }
+
+    ASSERT_EQ(2, s.levels.size());
+    EXPECT_EQ(1, s.levels[0].tasks);
+    EXPECT_EQ(2, s.levels[1].tasks);
+    EXPECT_EQ(1, s.levels[0].queue_wait.count);
+    EXPECT_EQ(2, s.levels[1].queue_wait.count);
+    EXPECT_EQ(0, s.levels[1].depth);
+}
@@ -0,0 +1,153 @@
+#include <execution/monotonic_arena.hpp>
+
+#include <execution/ensure_started.hpp>
+#include <execution/just.hpp>
+#include <execution/start_detached.hpp>
+#include <execution/sync_wait.hpp>
+#include <execution/then.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+using namespace execution;
+
+namespace {
+
+// the allocations of the whole test, and the size of the last one
+std::atomic<std::size_t> allocations = 0;
+std::atomic<std::size_t> last_size = 0;
+
+}   // namespace
+
+void* operator new(std::size_t size)
+{
+    ++allocations;
+    last_size = size;
+
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+
+// not inlined: gcc would take the free() of a pointer from the global
+// operator new for a mismatch
+[[ gnu::noinline ]] void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+[[ gnu::noinline ]] void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST(monotonic_arena, alignment)
+{
+    monotonic_arena arena {64};
+
+    for (std::size_t alignment: {1, 2, 4, 8, 16, 32, 64}) {
+        auto* p = arena.allocate(3, alignment);
+        EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(p) % alignment);
+    }
+}
+
+TEST(monotonic_arena, buffer)
+{
+    alignas(std::max_align_t) std::byte buffer[256];
+
+    monotonic_arena arena {buffer, sizeof(buffer)};
+
+    auto* p0 = static_cast<std::byte*>(arena.allocate(100, 8));
+    auto* p1 = static_cast<std::byte*>(arena.allocate(100, 8));
+
+    EXPECT_EQ(buffer, p0);
+    EXPECT_LE(p0 + 100, p1);
+    EXPECT_GE(buffer + sizeof(buffer), p1 + 100);
+
+    // doesn't fit into the buffer anymore
+    auto* p2 = static_cast<std::byte*>(arena.allocate(100, 8));
+    EXPECT_TRUE(p2 < buffer || p2 >= buffer + sizeof(buffer));
+}
+
+TEST(monotonic_arena, large)
+{
+    monotonic_arena arena {64};
+
+    auto* p = static_cast<char*>(arena.allocate(1 << 20, 16));
+    p[0] = 1;
+    p[(1 << 20) - 1] = 1;
+
+    arena.release();
+
+    EXPECT_NE(nullptr, arena.allocate(16, 16));
+}
+
+TEST(monotonic_arena, reuse)
+{
+    alignas(std::max_align_t) std::byte buffer[256];
+
+    monotonic_arena arena {buffer, sizeof(buffer)};
+
+    for (int i = 0; i != 3; ++i) {
+        auto const before = allocations.load();
+
+        EXPECT_EQ(buffer, arena.allocate(100, 8));
+        arena.allocate(100, 8);
+        EXPECT_EQ(before, allocations.load());
+
+        // spills over into a chunk of the initial size every time
+        arena.allocate(100, 8);
+        EXPECT_EQ(before + 1, allocations.load());
+        EXPECT_EQ(sizeof(buffer), last_size.load());
+
+        arena.release();
+    }
+}
+
+TEST(monotonic_arena, reuse_after_large)
+{
+    monotonic_arena arena {64};
+
+    for (int i = 0; i != 3; ++i) {
+        arena.allocate(1 << 20, 16);
+        arena.release();
+
+        // not a chunk twice as large as the last one
+        arena.allocate(16, 16);
+        EXPECT_EQ(64u, last_size.load());
+        arena.release();
+    }
+}
+
+TEST(monotonic_arena, allocator)
+{
+    monotonic_arena arena;
+
+    std::vector<int, arena_allocator<int>> v {arena_allocator<int>{arena}};
+    for (int i = 0; i != 1000; ++i) {
+        v.push_back(i);
+    }
+
+    EXPECT_EQ(999, v.back());
+}
+
+TEST(monotonic_arena, algorithms)
+{
+    monotonic_arena arena;
+    arena_allocator<std::byte> allocator {arena};
+
+    int value = 0;
+    start_detached(just(1) | then([&] (int x) { value = x; }), allocator);
+    EXPECT_EQ(1, value);
+
+    auto [r] = *this_thread::sync_wait(ensure_started(just(2), allocator));
+    EXPECT_EQ(2, r);
+}
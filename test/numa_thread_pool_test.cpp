@@ -0,0 +1,249 @@
+#include <execution/numa_thread_pool.hpp>
+
+#include <execution/bulk.hpp>
+#include <execution/schedule.hpp>
+#include <execution/start_detached.hpp>
+#include <execution/sync_wait.hpp>
+#include <execution/then.hpp>
+#include <execution/transfer_just.hpp>
+#include <execution/when_all_range.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+using namespace execution;
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// sysfs-like node directory in a temporary location
+struct fake_sysfs
+{
+    std::filesystem::path _root;
+
+    explicit fake_sysfs(std::string const& name)
+        : _root {std::filesystem::temp_directory_path() / name}
+    {
+        std::filesystem::remove_all(_root);
+        std::filesystem::create_directories(_root);
+    }
+
+    ~fake_sysfs()
+    {
+        std::filesystem::remove_all(_root);
+    }
+
+    void add_node(int id, std::string const& cpulist, std::string const& distance)
+    {
+        auto const dir = _root / ("node" + std::to_string(id));
+        std::filesystem::create_directories(dir);
+
+        std::ofstream{dir / "cpulist"} << cpulist << '\n';
+        std::ofstream{dir / "distance"} << distance << '\n';
+    }
+};
+
+// two nodes sharing CPU 0, so that pinning works on any machine
+numa_topology two_nodes()
+{
+    return numa_topology{{
+        numa_node{.id = 0, .cpus = {0}, .distances = {10, 21}},
+        numa_node{.id = 1, .cpus = {0}, .distances = {21, 10}},
+    }};
+}
+
+}   // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST(numa_topology, parse_cpu_list)
+{
+    EXPECT_EQ((std::vector{0, 1, 2, 3, 8, 10, 11}), parse_cpu_list("0-3,8,10-11\n"));
+    EXPECT_EQ((std::vector{5}), parse_cpu_list("5"));
+    EXPECT_TRUE(parse_cpu_list("\n").empty());
+}
+
+TEST(numa_topology, discover)
+{
+    fake_sysfs sysfs {"numa_topology_test"};
+
+    sysfs.add_node(0, "0-1", "10 21 31");
+    sysfs.add_node(2, "2-3", "31 21 10");
+    // memory only
+    sysfs.add_node(1, "", "21 10 21");
+
+    std::ofstream{sysfs._root / "online"} << "0-2\n";
+
+    auto const topology = numa_topology::discover(sysfs._root);
+
+    ASSERT_EQ(2u, topology.size());
+
+    auto const& nodes = topology.nodes();
+
+    EXPECT_EQ(0, nodes[0].id);
+    EXPECT_EQ((std::vector{0, 1}), nodes[0].cpus);
+    EXPECT_EQ((std::vector{10, 31}), nodes[0].distances);
+
+    EXPECT_EQ(2, nodes[1].id);
+    EXPECT_EQ((std::vector{2, 3}), nodes[1].cpus);
+    EXPECT_EQ((std::vector{31, 10}), nodes[1].distances);
+
+    EXPECT_EQ((std::vector<std::size_t>{1}), topology.neighbours(0));
+}
+
+TEST(numa_topology, fallback)
+{
+    auto const topology = numa_topology::discover("/nonexistent");
+
+    ASSERT_EQ(1u, topology.size());
+    EXPECT_FALSE(topology.nodes()[0].cpus.empty());
+}
+
+TEST(numa_topology, neighbours)
+{
+    numa_topology const topology {{
+        numa_node{.id = 0, .cpus = {0}, .distances = {10, 32, 21}},
+        numa_node{.id = 1, .cpus = {1}, .distances = {32, 10, 21}},
+        numa_node{.id = 2, .cpus = {2}, .distances = {21, 21, 10}},
+    }};
+
+    EXPECT_EQ((std::vector<std::size_t>{2, 1}), topology.neighbours(0));
+    EXPECT_EQ((std::vector<std::size_t>{2, 0}), topology.neighbours(1));
+    EXPECT_EQ((std::vector<std::size_t>{0, 1}), topology.neighbours(2));
+}
+
+TEST(numa_thread_pool, schedule)
+{
+    numa_thread_pool pool {two_nodes(), 2};
+
+    EXPECT_EQ(4u, pool.size());
+    EXPECT_EQ(numa_thread_pool::no_node, pool.current_node());
+
+    auto sched = pool.get_scheduler();
+
+    auto node = [&] { return pool.current_node(); };
+
+    std::vector<decltype(schedule(sched) | then(node))> senders;
+    for (int i = 0; i != 100; ++i) {
+        senders.push_back(schedule(sched) | then(node));
+    }
+
+    auto [nodes] = *this_thread::sync_wait(when_all_range(std::move(senders)));
+
+    ASSERT_EQ(100u, nodes.size());
+    for (auto node: nodes) {
+        EXPECT_LT(node, 2u);
+    }
+}
+
+TEST(numa_thread_pool, allowed_cpus)
+{
+    // CPU 1000 is out of the affinity mask of the test
+    numa_topology topology {{
+        numa_node{.id = 0, .cpus = {0, 1000}, .distances = {10, 21}},
+        numa_node{.id = 1, .cpus = {1000}, .distances = {21, 10}},
+    }};
+
+    numa_thread_pool pool {std::move(topology)};
+
+    EXPECT_EQ(1u, pool.size());
+    EXPECT_EQ((std::pair{0, 100}), pool.bulk_range(0, 100));
+    EXPECT_EQ((std::pair{100, 100}), pool.bulk_range(1, 100));
+
+    // the tasks of node 1 are stolen by node 0
+    std::vector<decltype(schedule(pool.get_scheduler()))> senders;
+    for (int i = 0; i != 10; ++i) {
+        senders.push_back(schedule(pool.get_scheduler()));
+    }
+
+    EXPECT_TRUE(this_thread::sync_wait(when_all_range(std::move(senders))));
+}
+
+TEST(numa_thread_pool, no_allowed_cpu)
+{
+    numa_topology topology {{
+        numa_node{.id = 0, .cpus = {1000}, .distances = {10}},
+    }};
+
+    EXPECT_THROW(numa_thread_pool{std::move(topology)}, std::system_error);
+}
+
+TEST(numa_thread_pool, bulk)
+{
+    numa_thread_pool pool {two_nodes(), 1};
+
+    EXPECT_EQ((std::pair{0, 50}), pool.bulk_range(0, 100));
+    EXPECT_EQ((std::pair{50, 100}), pool.bulk_range(1, 100));
+
+    std::vector<std::atomic<int>> hits(100);
+
+    auto r = this_thread::sync_wait(
+        transfer_just(pool.get_scheduler())
+            | bulk(100, [&] (int i) {
+                hits[i].fetch_add(1);
+            }));
+
+    EXPECT_TRUE(r.has_value());
+    for (auto const& h: hits) {
+        EXPECT_EQ(1, h.load());
+    }
+}
+
+TEST(numa_thread_pool, stop)
+{
+    numa_thread_pool pool {two_nodes(), 1};
+
+    auto sched = pool.get_scheduler();
+
+    std::promise<void> gate;
+    std::promise<void> busy;
+    auto opened = gate.get_future().share();
+
+    start_detached(schedule(sched) | then([opened, &busy] {
+        busy.set_value();
+        opened.wait();
+    }));
+
+    busy.get_future().wait();
+
+    // each task schedules the next one while the pool is stopping: all of
+    // them run, on a worker or on the last one to leave
+    std::atomic<int> ran = 0;
+    std::function<void()> next = [&] {
+        if (++ran < 10) {
+            start_detached(schedule(sched) | then(next));
+        }
+    };
+
+    start_detached(schedule(sched) | then(next));
+
+    auto stopped = std::async(std::launch::async, [&] {
+        pool.stop();
+    });
+
+    std::this_thread::sleep_for(10ms);
+    gate.set_value();
+    stopped.wait();
+
+    EXPECT_EQ(10, ran);
+
+    // once the workers are gone, on the calling thread
+    auto const caller = std::this_thread::get_id();
+    auto [id] = *this_thread::sync_wait(schedule(sched) | then([] {
+        return std::this_thread::get_id();
+    }));
+
+    EXPECT_EQ(caller, id);
+}
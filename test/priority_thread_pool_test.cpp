@@ -0,0 +1,186 @@
+#include <execution/priority_thread_pool.hpp>
+
+#include <execution/schedule.hpp>
+#include <execution/start_detached.hpp>
+#include <execution/sync_wait.hpp>
+#include <execution/then.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+using namespace execution;
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST(multilevel_task_queue, strict)
+{
+    multilevel_task_queue queue {{.levels = 4, .aging_period = 0}};
+
+    task_base tasks[5];
+
+    queue.enqueue(3, &tasks[0]);
+    queue.enqueue(1, &tasks[1]);
+    queue.enqueue(2, &tasks[2]);
+    queue.enqueue(0, &tasks[3]);
+    queue.enqueue(1, &tasks[4]);
+
+    EXPECT_EQ(5u, queue.size());
+
+    EXPECT_EQ(&tasks[3], queue.try_dequeue());
+    EXPECT_EQ(&tasks[1], queue.try_dequeue());
+    EXPECT_EQ(&tasks[4], queue.try_dequeue());
+    EXPECT_EQ(&tasks[2], queue.try_dequeue());
+    EXPECT_EQ(&tasks[0], queue.try_dequeue());
+
+    EXPECT_EQ(0u, queue.size());
+    EXPECT_EQ(nullptr, queue.try_dequeue());
+}
+
+TEST(multilevel_task_queue, clamped)
+{
+    multilevel_task_queue queue {{.levels = 2, .aging_period = 0}};
+
+    task_base low;
+    task_base high;
+
+    queue.enqueue(100, &low);
+    queue.enqueue(1, &high);
+
+    EXPECT_EQ(&low, queue.try_dequeue());
+    EXPECT_EQ(&high, queue.try_dequeue());
+}
+
+TEST(multilevel_task_queue, aging)
+{
+    multilevel_task_queue queue {{.levels = 8, .aging_period = 2}};
+
+    task_base background;
+    task_base interactive;
+
+    queue.enqueue(7, &background);
+
+    // a steady stream of urgent tasks doesn't starve the background one
+    int served = 0;
+    for (;; ++served) {
+        queue.enqueue(0, &interactive);
+
+        if (queue.try_dequeue() == &background) {
+            break;
+        }
+
+        ASSERT_LT(served, 100);
+    }
+
+    // ranked 0 after 7 * 2 dequeues, then wins as the older one
+    EXPECT_EQ(14, served);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST(priority_thread_pool, schedule)
+{
+    priority_thread_pool pool {2};
+
+    EXPECT_EQ(8u, pool.levels());
+
+    auto sched = pool.get_scheduler();
+    EXPECT_EQ(4u, sched.priority());
+
+    auto [a] = *this_thread::sync_wait(schedule(sched) | then([] { return 1; }));
+    auto [b] = *this_thread::sync_wait(
+        schedule(sched.with_priority(0)) | then([] { return 2; }));
+
+    EXPECT_EQ(1, a);
+    EXPECT_EQ(2, b);
+}
+
+TEST(priority_thread_pool, order)
+{
+    priority_thread_pool pool {
+        thread_pool_options{.worker_count = 1},
+        priority_options{.levels = 3, .aging_period = 0}
+    };
+
+    auto sched = pool.get_scheduler();
+
+    // keeps the only worker busy while the others are queued
+    std::promise<void> gate;
+    std::promise<void> busy;
+    auto opened = gate.get_future().share();
+
+    start_detached(schedule(sched) | then([opened, &busy] {
+        busy.set_value();
+        opened.wait();
+    }));
+
+    busy.get_future().wait();
+
+    std::mutex mtx;
+    std::vector<std::size_t> order;
+    std::promise<void> done;
+
+    for (std::size_t p: {2, 1, 0, 2, 0}) {
+        start_detached(schedule(sched.with_priority(p)) | then([&, p] {
+            std::unique_lock lock {mtx};
+            order.push_back(p);
+            if (order.size() == 5) {
+                done.set_value();
+            }
+        }));
+    }
+
+    gate.set_value();
+    done.get_future().wait();
+
+    EXPECT_EQ((std::vector<std::size_t>{0, 0, 1, 2, 2}), order);
+}
+
+TEST(priority_thread_pool, stop)
+{
+    priority_thread_pool pool {
+        thread_pool_options{.worker_count = 1},
+        priority_options{.levels = 3, .aging_period = 1}
+    };
+
+    auto sched = pool.get_scheduler().with_priority(0);
+
+    std::promise<void> gate;
+    std::promise<void> busy;
+    auto opened = gate.get_future().share();
+
+    start_detached(schedule(sched) | then([opened, &busy] {
+        busy.set_value();
+        opened.wait();
+    }));
+
+    busy.get_future().wait();
+
+    // each task schedules the next one while the pool is stopping: all of
+    // them run however long the stop waits in the queue
+    std::atomic<int> ran = 0;
+    std::function<void()> next = [&] {
+        if (++ran < 10) {
+            start_detached(schedule(sched) | then(next));
+        }
+    };
+
+    start_detached(schedule(sched) | then(next));
+
+    auto stopped = std::async(std::launch::async, [&] {
+        pool.stop();
+    });
+
+    std::this_thread::sleep_for(10ms);
+    gate.set_value();
+    stopped.wait();
+
+    EXPECT_EQ(10, ran);
+}
@@ -0,0 +1,99 @@
+#include <execution/run_loop.hpp>
+
+#include <execution/just.hpp>
+#include <execution/on.hpp>
+#include <execution/schedule.hpp>
+#include <execution/start_detached.hpp>
+#include <execution/then.hpp>
+#include <execution/transfer_just.hpp>
+
+#include <execution/null_receiver.hpp>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+using namespace execution;
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST(run_loop, traits)
+{
+    run_loop loop;
+
+    auto sched = loop.get_scheduler();
+
+    EXPECT_EQ(sched, loop.get_scheduler());
+
+    constexpr auto s0_type = meta::atom<decltype(schedule(sched))>{};
+    constexpr auto receiver_type = meta::atom<null_receiver>{};
+
+    static_assert(traits::sender_values(s0_type, receiver_type)
+        == meta::list<signature<>>{});
+}
+
+TEST(run_loop, fifo)
+{
+    run_loop loop;
+
+    auto sched = loop.get_scheduler();
+
+    std::vector<int> order;
+
+    for (int i = 0; i != 8; ++i) {
+        start_detached(schedule(sched) | then([&, i] {
+            order.push_back(i);
+        }));
+    }
+
+    start_detached(schedule(sched) | then([&] {
+        loop.finish();
+    }));
+
+    loop.run();
+
+    EXPECT_EQ((std::vector{0, 1, 2, 3, 4, 5, 6, 7}), order);
+}
+
+TEST(run_loop, on)
+{
+    run_loop loop;
+
+    auto const this_id = std::this_thread::get_id();
+
+    std::thread::id id;
+
+    std::thread t {[&] {
+        start_detached(
+            on(loop.get_scheduler(), just() | then([&] {
+                id = std::this_thread::get_id();
+                loop.finish();
+            })));
+    }};
+
+    loop.run();
+    t.join();
+
+    EXPECT_EQ(this_id, id);
+}
+
+TEST(run_loop, transfer_just)
+{
+    run_loop loop;
+
+    int result = 0;
+
+    start_detached(
+        transfer_just(loop.get_scheduler(), 40, 2)
+            | then([&] (int x, int y) {
+                result = x + y;
+                loop.finish();
+            }));
+
+    EXPECT_EQ(0, result);
+
+    loop.run();
+
+    EXPECT_EQ(42, result);
+}
@@ -0,0 +1,89 @@
+#include <execution/slab_allocator.hpp>
+
+#include <execution/just.hpp>
+#include <execution/start_detached.hpp>
+#include <execution/then.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <list>
+#include <thread>
+
+using namespace execution;
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST(slab_allocator, recycle)
+{
+    slab_allocator<std::byte> allocator;
+
+    auto* p0 = allocator.allocate(100);
+    allocator.deallocate(p0, 100);
+
+    // same size class
+    auto* p1 = allocator.allocate(120);
+    EXPECT_EQ(p0, p1);
+
+    // different size class
+    auto* p2 = allocator.allocate(20);
+    EXPECT_NE(p1, p2);
+
+    allocator.deallocate(p1, 120);
+    allocator.deallocate(p2, 20);
+}
+
+TEST(slab_allocator, alignment)
+{
+    slab_allocator<long double> allocator;
+
+    for (std::size_t n = 1; n != 100; ++n) {
+        auto* p = allocator.allocate(n);
+        EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(p) % alignof(long double));
+        allocator.deallocate(p, n);
+    }
+}
+
+TEST(slab_allocator, large)
+{
+    slab_allocator<std::byte> allocator;
+
+    auto const size = slab_impl::max_block_size + 1;
+
+    auto* p = allocator.allocate(size);
+    p[size - 1] = std::byte{1};
+    allocator.deallocate(p, size);
+}
+
+TEST(slab_allocator, container)
+{
+    std::list<int, slab_allocator<int>> list;
+    for (int i = 0; i != 1000; ++i) {
+        list.push_back(i);
+    }
+
+    EXPECT_EQ(1000, list.size());
+}
+
+TEST(slab_allocator, threads)
+{
+    slab_allocator<std::byte> allocator;
+
+    auto* p = allocator.allocate(64);
+
+    // freed into the cache of a thread that exits right away
+    std::thread{[&] { allocator.deallocate(p, 64); }}.join();
+}
+
+TEST(slab_allocator, start_detached)
+{
+    int sum = 0;
+
+    for (int i = 0; i != 10; ++i) {
+        start_detached(
+            just(i) | then([&] (int x) { sum += x; }),
+            slab_allocator<std::byte>{});
+    }
+
+    EXPECT_EQ(45, sum);
+}
@@ -0,0 +1,105 @@
+#include <execution/spin_wait.hpp>
+#include <execution/thread_pool.hpp>
+
+#include <execution/schedule.hpp>
+#include <execution/start_detached.hpp>
+#include <execution/sync_wait.hpp>
+#include <execution/then.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+
+using namespace std::chrono_literals;
+using namespace execution;
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST(adaptive_spin, wait)
+{
+    if (std::thread::hardware_concurrency() == 1) {
+        GTEST_SKIP() << "never spins on a single CPU";
+    }
+
+    adaptive_spin spin;
+
+    EXPECT_TRUE(spin.wait([] { return true; }));
+    EXPECT_FALSE(spin.wait([] { return false; }));
+
+    int calls = 0;
+    EXPECT_TRUE(spin.wait([&] { return ++calls == 3; }));
+    EXPECT_EQ(3, calls);
+}
+
+TEST(adaptive_spin, disabled)
+{
+    adaptive_spin spin {0};
+
+    int calls = 0;
+    EXPECT_FALSE(spin.wait([&] { return ++calls != 0; }));
+    EXPECT_EQ(0, calls);
+}
+
+TEST(adaptive_spin, other_thread)
+{
+    adaptive_spin spin;
+    std::atomic<bool> flag = false;
+
+    std::thread t {[&] {
+        flag = true;
+    }};
+
+    // gives up at some point, whether or not it saw the flag
+    while (!flag.load()) {
+        spin.wait([&] { return flag.load(); });
+    }
+
+    t.join();
+    EXPECT_TRUE(flag.load());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+// every task must run, whether the workers spin, park or do both
+void ping_pong(std::uint32_t spin_limit)
+{
+    thread_pool pool {thread_pool_options{.worker_count = 2, .spin_limit = spin_limit}};
+
+    auto sched = pool.get_scheduler();
+
+    for (int i = 0; i != 1000; ++i) {
+        auto [r] = *this_thread::sync_wait(schedule(sched) | then([i] { return i; }));
+        EXPECT_EQ(i, r);
+    }
+
+    // with idle gaps, so that the workers park in between
+    for (int i = 0; i != 20; ++i) {
+        std::this_thread::sleep_for(1ms);
+
+        std::atomic<int> count = 10;
+        std::promise<void> done;
+
+        for (int k = 0; k != 10; ++k) {
+            start_detached(schedule(sched) | then([&] {
+                if (count.fetch_sub(1) == 1) {
+                    done.set_value();
+                }
+            }));
+        }
+
+        done.get_future().wait();
+    }
+}
+
+TEST(task_queue, spin)
+{
+    ping_pong(adaptive_spin::default_limit);
+}
+
+TEST(task_queue, park)
+{
+    ping_pong(0);
+}
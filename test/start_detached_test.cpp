@@ -9,6 +9,7 @@
 #include <gtest/gtest.h>
 
 #include <chrono>
+#include <future>
 
 using namespace std::chrono_literals;
 using namespace execution;
@@ -1,5 +1,6 @@
 #include <execution/sync_wait.hpp>
 
+#include <execution/get_scheduler.hpp>
 #include <execution/just.hpp>
 #include <execution/schedule.hpp>
 #include <execution/then.hpp>
@@ -7,6 +8,9 @@
 
 #include <gtest/gtest.h>
 
+#include <optional>
+#include <thread>
+
 using namespace std::chrono_literals;
 
 using namespace execution;
@@ -109,3 +113,65 @@ TEST(sync_wait, cancellation)
 
     EXPECT_FALSE(r.has_value());
 }
+
+TEST(sync_wait, inplace_stop_token)
+{
+    timed_thread_pool pool {1};
+
+    auto sched = pool.get_scheduler();
+
+    inplace_stop_source ss;
+    ss.request_stop();
+
+    auto r = schedule_after(sched, 10ms)
+        | then([] { return 42; })
+        | this_thread::sync_wait(ss.get_token());
+
+    EXPECT_FALSE(r.has_value());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+// completes on the scheduler provided by the receiver
+struct schedule_on_receiver_scheduler
+{
+    using values_t = meta::list<signature<>>;
+    using errors_t = meta::list<std::exception_ptr>;
+
+    template <typename R>
+    struct operation_t
+    {
+        using schedule_operation_t = decltype(execution::connect(
+            schedule(get_scheduler(std::declval<R const&>())),
+            std::declval<R>()));
+
+        R _receiver;
+        std::optional<schedule_operation_t> _operation = {};
+
+        void start() &
+        {
+            auto sched = get_scheduler(_receiver);
+            execution::start(_operation.emplace(execution::connect(
+                schedule(sched),
+                std::move(_receiver))));
+        }
+    };
+
+    template <typename R>
+    auto connect(R&& receiver) -> operation_t<std::decay_t<R>>
+    {
+        return {std::forward<R>(receiver)};
+    }
+};
+
+TEST(sync_wait, run_loop)
+{
+    auto const this_id = std::this_thread::get_id();
+
+    auto r = schedule_on_receiver_scheduler{}
+        | then([] { return std::this_thread::get_id(); })
+        | this_thread::sync_wait();
+
+    ASSERT_TRUE(r.has_value());
+    EXPECT_EQ(this_id, std::get<0>(*r));
+}
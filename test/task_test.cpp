@@ -0,0 +1,267 @@
+#include <execution/task.hpp>
+
+#include <execution/just.hpp>
+#include <execution/just_stopped.hpp>
+#include <execution/null_receiver.hpp>
+#include <execution/schedule.hpp>
+#include <execution/slab_allocator.hpp>
+#include <execution/sync_wait.hpp>
+#include <execution/then.hpp>
+#include <execution/thread_pool.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+using namespace execution;
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+
+task<int> answer()
+{
+    co_return 42;
+}
+
+task<int> add(int x, int y)
+{
+    int const a = co_await just(x);
+    int const b = co_await (just(y) | then([] (int v) { return v * 10; }));
+    co_return a + b;
+}
+
+task<> fail()
+{
+    throw std::runtime_error{"error"};
+    co_return;
+}
+
+task<int> recursive(int n)
+{
+    if (n == 0) {
+        co_return 0;
+    }
+    co_return 1 + co_await recursive(n - 1);
+}
+
+struct allocation_stats
+{
+    int _allocations = 0;
+    int _deallocations = 0;
+};
+
+template <typename T>
+struct counting_allocator
+{
+    using value_type = T;
+
+    allocation_stats* _stats;
+
+    explicit counting_allocator(allocation_stats* stats) noexcept
+        : _stats{stats}
+    {}
+
+    template <typename U>
+    counting_allocator(counting_allocator<U> const& other) noexcept
+        : _stats{other._stats}
+    {}
+
+    T* allocate(std::size_t n)
+    {
+        ++_stats->_allocations;
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept
+    {
+        ++_stats->_deallocations;
+        std::allocator<T>{}.deallocate(p, n);
+    }
+};
+
+}   // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST(task, traits)
+{
+    constexpr auto receiver_type = meta::atom<null_receiver>{};
+
+    static_assert(traits::sender_values(meta::atom<task<int>>{}, receiver_type)
+        == meta::list<signature<int>>{});
+
+    static_assert(traits::sender_values(meta::atom<task<>>{}, receiver_type)
+        == meta::list<signature<>>{});
+
+    static_assert(traits::sender_errors(meta::atom<task<int>>{}, receiver_type)
+        == meta::list<std::exception_ptr>{});
+}
+
+TEST(task, value)
+{
+    auto [r] = *this_thread::sync_wait(answer());
+    EXPECT_EQ(42, r);
+}
+
+TEST(task, await_sender)
+{
+    auto [r] = *this_thread::sync_wait(add(1, 2));
+    EXPECT_EQ(21, r);
+}
+
+TEST(task, await_task)
+{
+    auto t = [] () -> task<int> {
+        int const a = co_await answer();
+        int const b = co_await add(1, 1);
+        co_return a + b;
+    };
+
+    auto [r] = *this_thread::sync_wait(t());
+    EXPECT_EQ(53, r);
+}
+
+TEST(task, exception)
+{
+    EXPECT_THROW(this_thread::sync_wait(fail()), std::runtime_error);
+
+    auto t = [] () -> task<bool> {
+        try {
+            co_await fail();
+        } catch (std::runtime_error const&) {
+            co_return true;
+        }
+        co_return false;
+    };
+
+    auto [r] = *this_thread::sync_wait(t());
+    EXPECT_TRUE(r);
+}
+
+TEST(task, sender_error)
+{
+    auto t = [] () -> task<int> {
+        co_await (just() | then([] { throw std::logic_error{"error"}; }));
+        co_return 0;
+    };
+
+    EXPECT_THROW(this_thread::sync_wait(t()), std::logic_error);
+}
+
+TEST(task, stopped)
+{
+    bool resumed = false;
+
+    auto inner = [&] () -> task<> {
+        co_await just_stopped();
+        resumed = true;
+    };
+
+    auto outer = [&] () -> task<int> {
+        co_await inner();
+        resumed = true;
+        co_return 1;
+    };
+
+    auto r = this_thread::sync_wait(outer());
+
+    EXPECT_FALSE(r.has_value());
+    EXPECT_FALSE(resumed);
+}
+
+TEST(task, thread_pool)
+{
+    thread_pool pool {1};
+    auto sched = pool.get_scheduler();
+
+    auto t = [&] () -> task<bool> {
+        auto const id = std::this_thread::get_id();
+        co_await schedule(sched);
+        co_return id != std::this_thread::get_id();
+    };
+
+    auto [r] = *this_thread::sync_wait(t());
+    EXPECT_TRUE(r);
+}
+
+TEST(task, stop_token)
+{
+    thread_pool pool {1};
+    auto sched = pool.get_scheduler();
+
+    std::stop_source stop_source;
+    stop_source.request_stop();
+
+    bool resumed = false;
+
+    auto t = [&] () -> task<> {
+        // the pool completes with set_stopped on a stop request
+        co_await schedule(sched);
+        resumed = true;
+    };
+
+    auto r = this_thread::sync_wait(t(), stop_source);
+
+    EXPECT_FALSE(r.has_value());
+    EXPECT_FALSE(resumed);
+}
+
+TEST(task, no_stack_growth)
+{
+    auto loop = [] () -> task<int> {
+        int sum = 0;
+        for (int i = 0; i != 1'000'000; ++i) {
+            sum += co_await just(1);
+        }
+        co_return sum;
+    };
+
+    auto [r0] = *this_thread::sync_wait(loop());
+    EXPECT_EQ(1'000'000, r0);
+
+    // awaiting tasks relies on symmetric transfer being compiled to tail
+    // calls, which gcc doesn't do without optimizations
+    auto tasks = [] () -> task<int> {
+        int sum = 0;
+        for (int i = 0; i != 10'000; ++i) {
+            sum += co_await answer();
+        }
+        co_return sum;
+    };
+
+    auto [r1] = *this_thread::sync_wait(tasks());
+    EXPECT_EQ(420'000, r1);
+
+    auto [r2] = *this_thread::sync_wait(recursive(10'000));
+    EXPECT_EQ(10'000, r2);
+}
+
+TEST(task, frame_allocator)
+{
+    allocation_stats stats;
+
+    auto t = [] (std::allocator_arg_t, counting_allocator<std::byte>, int x)
+        -> task<int>
+    {
+        co_return x + co_await just(1);
+    };
+
+    {
+        auto [r] = *this_thread::sync_wait(
+            t(std::allocator_arg, counting_allocator<std::byte>{&stats}, 41));
+        EXPECT_EQ(42, r);
+    }
+
+    EXPECT_EQ(1, stats._allocations);
+    EXPECT_EQ(1, stats._deallocations);
+
+    auto s = [] (std::allocator_arg_t, slab_allocator<std::byte>) -> task<int> {
+        co_return co_await answer();
+    };
+
+    auto [r] = *this_thread::sync_wait(s(std::allocator_arg, {}));
+    EXPECT_EQ(42, r);
+}
@@ -0,0 +1,189 @@
+#include <execution/thread_options.hpp>
+#include <execution/thread_pool.hpp>
+#include <execution/timed_thread_pool.hpp>
+
+#include <execution/schedule.hpp>
+#include <execution/sync_wait.hpp>
+#include <execution/then.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <string>
+#include <tuple>
+#include <system_error>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace execution;
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+
+#if defined(__linux__)
+
+std::string current_name()
+{
+    char name[16] = {};
+    pthread_getname_np(pthread_self(), name, sizeof(name));
+    return name;
+}
+
+std::set<int> current_cpus()
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    sched_getaffinity(0, sizeof(set), &set);
+
+    std::set<int> cpus;
+    for (int cpu = 0; cpu != CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &set)) {
+            cpus.insert(cpu);
+        }
+    }
+    return cpus;
+}
+
+std::size_t current_stack_size()
+{
+    pthread_attr_t attr;
+    pthread_getattr_np(pthread_self(), &attr);
+
+    std::size_t size = 0;
+    pthread_attr_getstacksize(&attr, &size);
+    pthread_attr_destroy(&attr);
+
+    return size;
+}
+
+// names of all the threads of the process
+std::multiset<std::string> thread_names()
+{
+    std::multiset<std::string> names;
+
+    for (auto const& entry: std::filesystem::directory_iterator{"/proc/self/task"}) {
+        std::string name;
+        std::getline(std::ifstream{entry.path() / "comm"}, name);
+        names.insert(name);
+    }
+
+    return names;
+}
+
+#endif
+
+}   // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST(thread_options, worker)
+{
+    thread_pool_options options {
+        .name = "pool",
+        .worker_cpus = {{0}, {0, 1}},
+        .stack_size = 1 << 20,
+        .nice = 5,
+    };
+
+    auto const w0 = options.worker(0);
+    EXPECT_EQ("pool-0", w0.name);
+    EXPECT_EQ((std::vector{0}), w0.cpus);
+    EXPECT_EQ(1u << 20, w0.stack_size);
+    EXPECT_EQ(5, w0.nice);
+
+    EXPECT_EQ((std::vector{0, 1}), options.worker(1).cpus);
+    EXPECT_EQ((std::vector{0}), options.worker(2).cpus);
+}
+
+TEST(thread_options, long_name)
+{
+    thread_pool_options options {.name = "a-very-long-pool-name"};
+
+    // the index is kept
+    EXPECT_EQ("a-very-long-p-0", options.worker(0).name);
+    EXPECT_EQ("a-very-long-123", options.worker(123).name);
+}
+
+TEST(thread_options, on_worker_start)
+{
+    std::mutex mtx;
+    std::set<std::size_t> started;
+
+    {
+        thread_pool pool {thread_pool_options{
+            .worker_count = 3,
+            .on_worker_start = [&] (std::size_t index) {
+                std::unique_lock lock {mtx};
+                started.insert(index);
+            },
+        }};
+
+        EXPECT_EQ(3u, pool.options().worker_count);
+    }
+
+    EXPECT_EQ((std::set<std::size_t>{0, 1, 2}), started);
+}
+
+#if defined(__linux__)
+
+TEST(thread_options, attributes)
+{
+    thread_pool pool {thread_pool_options{
+        .worker_count = 2,
+        .name = "compute",
+        .worker_cpus = {{0}},
+        .stack_size = 4 << 20,
+    }};
+
+    auto sched = pool.get_scheduler();
+
+    auto [r] = *this_thread::sync_wait(
+        schedule(sched) | then([] {
+            return std::tuple{current_name(), current_cpus(), current_stack_size()};
+        }));
+
+    auto const& [name, cpus, stack] = r;
+
+    EXPECT_EQ(0u, name.rfind("compute-", 0));
+    EXPECT_EQ((std::set{0}), cpus);
+    EXPECT_LE(4u << 20, stack);
+}
+
+TEST(thread_options, dispatcher)
+{
+    timed_thread_pool pool {thread_pool_options{
+        .worker_count = 1,
+        .name = "timed",
+        .dispatcher = {.name = "timer"},
+    }};
+
+    auto const names = thread_names();
+
+    EXPECT_EQ(1u, names.count("timer"));
+    EXPECT_EQ(1u, names.count("timed-0"));
+}
+
+TEST(thread_options, invalid)
+{
+    std::atomic<bool> ran = false;
+
+    EXPECT_THROW(
+        (worker_thread{{.cpus = {-1}}, [&] { ran = true; }}),
+        std::system_error);
+
+    EXPECT_THROW(
+        (thread_pool{thread_pool_options{.worker_count = 2, .worker_cpus = {{0}, {-1}}}}),
+        std::system_error);
+
+    EXPECT_FALSE(ran.load());
+}
+
+#endif
@@ -5,16 +5,117 @@
 #include <execution/start_detached.hpp>
 #include <execution/sync_wait.hpp>
 #include <execution/then.hpp>
+#include <execution/upon_stopped.hpp>
 
 #include <gtest/gtest.h>
 
 #include <atomic>
 #include <chrono>
 #include <future>
+#include <thread>
+#include <vector>
 
 using namespace std::chrono_literals;
 using namespace execution;
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// counts its executions and signals when all the expected ones are done
+struct counting_task
+    : task_base
+{
+    std::atomic<int>* _remaining;
+    std::promise<void>* _done;
+
+    counting_task(std::atomic<int>& remaining, std::promise<void>& done)
+        : task_base {
+            ._execute = static_cast<task_base::execute_t>(&counting_task::execute)
+        }
+        , _remaining {&remaining}
+        , _done {&done}
+    {}
+
+    void execute()
+    {
+        if (_remaining->fetch_sub(1) == 1) {
+            _done->set_value();
+        }
+    }
+};
+
+template <typename P>
+void schedule_batch_of(P& pool, int count)
+{
+    std::atomic<int> remaining = count;
+    std::promise<void> done;
+
+    std::vector<counting_task> tasks;
+    tasks.reserve(count);
+
+    for (int i = 0; i != count; ++i) {
+        tasks.emplace_back(remaining, done);
+        if (i) {
+            tasks[i - 1]._next = &tasks[i];
+        }
+    }
+
+    pool.schedule_batch(&tasks.front(), &tasks.back());
+
+    done.get_future().wait();
+    EXPECT_EQ(0, remaining.load());
+}
+
+template <typename P>
+void schedule_n_of(P& pool, int count)
+{
+    std::atomic<int> remaining = count;
+    std::promise<void> done;
+
+    counting_task task {remaining, done};
+
+    pool.schedule_n(&task, count);
+
+    done.get_future().wait();
+    EXPECT_EQ(0, remaining.load());
+}
+
+// keeps the only worker of the pool busy until `gate` is opened, and
+// counts how the operations queued behind it complete
+struct blocked_pool
+{
+    thread_pool _pool {1};
+
+    std::promise<void> _gate;
+    std::atomic<int> _values = 0;
+    std::atomic<int> _stopped = 0;
+
+    explicit blocked_pool(int count)
+    {
+        auto sched = _pool.get_scheduler();
+
+        std::promise<void> busy;
+        auto opened = _gate.get_future().share();
+
+        start_detached(schedule(sched) | then([opened, &busy] {
+            busy.set_value();
+            opened.wait();
+        }));
+
+        busy.get_future().wait();
+
+        for (int i = 0; i != count; ++i) {
+            start_detached(
+                schedule(sched)
+                    | then([this] { ++_values; })
+                    | upon_stopped([this] { ++_stopped; }));
+        }
+    }
+};
+
+}   // namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 
 TEST(thread_pool, simple)
@@ -57,3 +158,127 @@ TEST(timed_thread_pool, timed)
     EXPECT_EQ(100, future.get());
     EXPECT_EQ(0, count.load());
 }
+
+TEST(thread_pool, schedule_batch)
+{
+    thread_pool pool {4};
+
+    schedule_batch_of(pool, 1);
+    schedule_batch_of(pool, 100);
+
+    schedule_n_of(pool, 1);
+    schedule_n_of(pool, 100);
+}
+
+TEST(thread_pool, stop)
+{
+    blocked_pool p {3};
+
+    p._gate.set_value();
+    p._pool.stop();
+
+    EXPECT_EQ(3, p._values);
+    EXPECT_EQ(0, p._stopped);
+
+    // the workers are gone: runs on this thread
+    auto [r] = *this_thread::sync_wait(
+        schedule(p._pool.get_scheduler()) | then([] { return 42; }));
+
+    EXPECT_EQ(42, r);
+}
+
+TEST(thread_pool, request_stop)
+{
+    blocked_pool p {3};
+
+    p._pool.request_stop();
+    EXPECT_TRUE(p._pool.stop_requested());
+
+    p._gate.set_value();
+    p._pool.stop();
+
+    EXPECT_EQ(0, p._values);
+    EXPECT_EQ(3, p._stopped);
+
+    EXPECT_FALSE(this_thread::sync_wait(schedule(p._pool.get_scheduler())));
+}
+
+TEST(thread_pool, stop_with_deadline)
+{
+    {
+        blocked_pool p {3};
+
+        p._gate.set_value();
+        p._pool.stop(std::chrono::steady_clock::now() + 1h);
+
+        EXPECT_EQ(3, p._values);
+        EXPECT_EQ(0, p._stopped);
+    }
+
+    {
+        blocked_pool p {3};
+
+        // still busy when the deadline expires
+        std::thread opener {[&] {
+            while (!p._pool.stop_requested()) {
+                std::this_thread::sleep_for(1ms);
+            }
+            p._gate.set_value();
+        }};
+
+        p._pool.stop(std::chrono::steady_clock::now() + 10ms);
+        opener.join();
+
+        EXPECT_EQ(0, p._values);
+        EXPECT_EQ(3, p._stopped);
+    }
+}
+
+TEST(thread_pool, join)
+{
+    thread_pool pool {2};
+
+    std::promise<void> joined;
+    auto future = joined.get_future();
+
+    start_detached(pool.join() | then([&] { joined.set_value(); }));
+
+    EXPECT_EQ(std::future_status::timeout, future.wait_for(10ms));
+
+    pool.request_stop();
+    future.wait();
+
+    // already joined: completes right away
+    EXPECT_TRUE(this_thread::sync_wait(pool.join()));
+}
+
+TEST(timed_thread_pool, schedule_batch)
+{
+    timed_thread_pool pool {4};
+
+    schedule_batch_of(pool, 100);
+    schedule_n_of(pool, 100);
+}
+
+TEST(timed_thread_pool, simultaneous_timers)
+{
+    timed_thread_pool pool {2};
+
+    auto sched = pool.get_scheduler();
+
+    std::atomic<int> count = 10;
+    std::promise<void> done;
+
+    auto const deadline = timed_thread_pool::clock_t::now() + 10ms;
+
+    for (int i = 0; i != 10; ++i) {
+        start_detached(schedule_at(sched, deadline) | then([&] {
+            if (count.fetch_sub(1) == 1) {
+                done.set_value();
+            }
+        }));
+    }
+
+    done.get_future().wait();
+    EXPECT_EQ(0, count.load());
+}
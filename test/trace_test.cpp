@@ -0,0 +1,199 @@
+#include <execution/with_trace.hpp>
+
+#include <execution/finally.hpp>
+#include <execution/just.hpp>
+#include <execution/let_value.hpp>
+#include <execution/null_receiver.hpp>
+#include <execution/repeat_effect_until.hpp>
+#include <execution/schedule.hpp>
+#include <execution/sync_wait.hpp>
+#include <execution/then.hpp>
+#include <execution/thread_pool.hpp>
+#include <execution/trace.hpp>
+#include <execution/upon_error.hpp>
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace execution;
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+
+int count_events(std::vector<trace_event> const& events, std::string_view name, char phase)
+{
+    int count = 0;
+    for (auto& e: events) {
+        if (e._name == name && e._phase == phase) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+}   // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST(trace, disabled_by_default)
+{
+    static_assert(std::is_same_v<
+        null_tracer,
+        decltype(get_tracer(null_receiver{}))>);
+
+    auto func = [] (int x) { return x + 1; };
+
+    // the user function isn't wrapped when tracing is disabled
+    static_assert(std::is_same_v<
+        decltype(func)&&,
+        decltype(trace_call(null_tracer{}, "func", std::move(func)))>);
+
+    auto [r] = *this_thread::sync_wait(just(1) | then(func));
+    EXPECT_EQ(2, r);
+}
+
+TEST(trace, then)
+{
+    trace_log log;
+
+    auto [r] = *this_thread::sync_wait(just(1)
+        | then([] (int x) { return x * 2; })
+        | then([] (int x) { return x + 1; })
+        | with_trace(log, "op"));
+
+    EXPECT_EQ(3, r);
+
+    auto const events = log.events();
+
+    EXPECT_EQ(1, count_events(events, "op", 'b'));
+    EXPECT_EQ(1, count_events(events, "op", 'e'));
+    EXPECT_EQ(2, count_events(events, "then", 'B'));
+    EXPECT_EQ(2, count_events(events, "then", 'E'));
+
+    ASSERT_FALSE(events.empty());
+    EXPECT_EQ('b', events.front()._phase);
+    EXPECT_EQ('e', events.back()._phase);
+    EXPECT_EQ(events.front()._id, events.back()._id);
+}
+
+TEST(trace, pipeline)
+{
+    trace_log log;
+    thread_pool pool {2};
+
+    int iterations = 0;
+
+    auto r = this_thread::sync_wait(schedule(pool.get_scheduler())
+        | let_value([&] {
+            return just()
+                | then([&] { ++iterations; })
+                | repeat_effect_until([&] { return iterations == 3; })
+                | then([] { throw std::runtime_error{"error"}; });
+        })
+        | upon_error([] (auto&&) {})
+        | finally(schedule(pool.get_scheduler()))
+        | with_trace(log, "pipeline"));
+
+    EXPECT_TRUE(r.has_value());
+    EXPECT_EQ(3, iterations);
+
+    // workers may still be closing their slices
+    pool.stop();
+
+    auto const events = log.events();
+
+    EXPECT_EQ(1, count_events(events, "pipeline", 'b'));
+    EXPECT_EQ(1, count_events(events, "pipeline", 'e'));
+    EXPECT_EQ(1, count_events(events, "let_value", 'B'));
+    EXPECT_EQ(3, count_events(events, "repeat_effect_until", 'b'));
+    EXPECT_EQ(3, count_events(events, "repeat_effect_until", 'e'));
+    EXPECT_EQ(3, count_events(events, "repeat_effect_until.condition", 'B'));
+    EXPECT_EQ(1, count_events(events, "upon_error", 'B'));
+    EXPECT_EQ(1, count_events(events, "finally", 'b'));
+    EXPECT_EQ(1, count_events(events, "finally", 'e'));
+
+    // both hops to the pool are connected with flow events
+    EXPECT_EQ(2, count_events(events, "schedule", 's'));
+    EXPECT_EQ(2, count_events(events, "schedule", 'f'));
+    EXPECT_EQ(2, count_events(events, "execute", 'B'));
+
+    // synchronous slices are balanced on every thread
+    std::map<std::uint32_t, int> depth;
+    for (auto& e: events) {
+        if (e._phase == 'B') {
+            ++depth[e._tid];
+        } else if (e._phase == 'E') {
+            EXPECT_GT(depth[e._tid]--, 0);
+        }
+    }
+    for (auto [tid, d]: depth) {
+        EXPECT_EQ(0, d);
+    }
+}
+
+TEST(trace, ring_overwrites_oldest)
+{
+    trace_log log {4};
+
+    static char const* const names[] = {"0", "1", "2", "3", "4", "5"};
+
+    tracer t {log};
+    for (auto* name: names) {
+        t.begin(name);
+    }
+
+    auto const events = log.events();
+
+    ASSERT_EQ(4, events.size());
+    EXPECT_STREQ("2", events.front()._name);
+    EXPECT_STREQ("5", events.back()._name);
+}
+
+TEST(trace, alternating_logs)
+{
+    trace_log first;
+    trace_log second;
+
+    tracer a {first};
+    tracer b {second};
+
+    for (int i = 0; i != 10; ++i) {
+        a.begin("a");
+        b.begin("b");
+    }
+
+    EXPECT_EQ(10, count_events(first.events(), "a", 'B'));
+    EXPECT_EQ(0, count_events(first.events(), "b", 'B'));
+    EXPECT_EQ(10, count_events(second.events(), "b", 'B'));
+}
+
+TEST(trace, chrome_json)
+{
+    trace_log log;
+
+    tracer t {log};
+    t.begin("sync");
+    t.end("sync");
+    t.async_begin("async \"op\"", &log);
+    t.async_end("async \"op\"", &log);
+
+    std::ostringstream os;
+    log.write_chrome_json(os);
+
+    auto const json = os.str();
+
+    EXPECT_EQ(0, json.find("{\"traceEvents\":["));
+    EXPECT_NE(std::string::npos, json.find("\"name\":\"sync\""));
+    EXPECT_NE(std::string::npos, json.find("\"ph\":\"B\""));
+    EXPECT_NE(std::string::npos, json.find("\"ph\":\"E\""));
+    EXPECT_NE(std::string::npos, json.find("\"name\":\"async \\\"op\\\"\""));
+    EXPECT_NE(std::string::npos, json.find("\"ph\":\"b\""));
+    EXPECT_NE(std::string::npos, json.find("\"id\":\"0x"));
+}
@@ -0,0 +1,152 @@
+#include <execution/when_all_range.hpp>
+
+#include <execution/just.hpp>
+#include <execution/null_receiver.hpp>
+#include <execution/schedule.hpp>
+#include <execution/sync_wait.hpp>
+#include <execution/then.hpp>
+#include <execution/thread_pool.hpp>
+#include <execution/timed_thread_pool.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+using namespace execution;
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST(when_all_range, traits)
+{
+    auto s0 = when_all_range(std::vector{just(1), just(2)});
+    auto s1 = when_all_range(std::vector{just(1, 'X')});
+    auto s2 = when_all_range(std::vector{just()});
+
+    int buf[2] {};
+    auto s3 = when_all_range(std::vector{just(1), just(2)}, &buf[0]);
+
+    constexpr auto s0_type = meta::atom<decltype(s0)>{};
+    constexpr auto s1_type = meta::atom<decltype(s1)>{};
+    constexpr auto s2_type = meta::atom<decltype(s2)>{};
+    constexpr auto s3_type = meta::atom<decltype(s3)>{};
+    constexpr auto receiver_type = meta::atom<null_receiver>{};
+
+    static_assert(traits::sender_errors(s0_type, receiver_type)
+        == meta::list<std::exception_ptr>{});
+
+    static_assert(traits::sender_values(s0_type, receiver_type)
+        == meta::list<signature<std::vector<int>>>{});
+
+    static_assert(traits::sender_values(s1_type, receiver_type)
+        == meta::list<signature<std::vector<std::tuple<int, char>>>>{});
+
+    static_assert(traits::sender_values(s2_type, receiver_type)
+        == meta::list<signature<>>{});
+
+    static_assert(traits::sender_values(s3_type, receiver_type)
+        == meta::list<signature<int*>>{});
+}
+
+TEST(when_all_range, simple)
+{
+    std::vector<decltype(just(0))> senders;
+    for (int i = 0; i != 100; ++i) {
+        senders.push_back(just(i));
+    }
+
+    auto [r] = *this_thread::sync_wait(when_all_range(std::move(senders)));
+
+    ASSERT_EQ(100, r.size());
+    for (int i = 0; i != 100; ++i) {
+        EXPECT_EQ(i, r[i]);
+    }
+}
+
+TEST(when_all_range, empty)
+{
+    auto [r] = *this_thread::sync_wait(
+        when_all_range(std::vector<decltype(just(0))>{}));
+
+    EXPECT_TRUE(r.empty());
+}
+
+TEST(when_all_range, no_value)
+{
+    auto r = this_thread::sync_wait(
+        when_all_range(std::vector{just(), just(), just()}));
+
+    EXPECT_TRUE(r.has_value());
+
+    static_assert(std::is_same_v<std::tuple<>, std::decay_t<decltype(*r)>>);
+}
+
+TEST(when_all_range, output_iterator)
+{
+    std::vector<int> out;
+
+    auto r = this_thread::sync_wait(when_all_range(
+        std::vector{just(1), just(2), just(3)},
+        std::back_inserter(out)));
+
+    EXPECT_TRUE(r.has_value());
+    EXPECT_EQ((std::vector{1, 2, 3}), out);
+}
+
+TEST(when_all_range, thread_pool)
+{
+    thread_pool pool {4};
+
+    auto sched = pool.get_scheduler();
+
+    auto make = [&] (int i) {
+        return schedule(sched) | then([i] { return i * i; });
+    };
+
+    std::vector<decltype(make(0))> senders;
+    for (int i = 0; i != 64; ++i) {
+        senders.push_back(make(i));
+    }
+
+    auto [r] = *this_thread::sync_wait(when_all_range(std::move(senders)));
+
+    ASSERT_EQ(64, r.size());
+    for (int i = 0; i != 64; ++i) {
+        EXPECT_EQ(i * i, r[i]);
+    }
+}
+
+TEST(when_all_range, error)
+{
+    timed_thread_pool pool {2};
+
+    auto sched = pool.get_scheduler();
+
+    std::atomic<int> count = 0;
+
+    auto make = [&] (int i) {
+        return schedule_after(sched, i ? 100ms : 0ms) | then([&, i] {
+            if (!i) {
+                throw std::runtime_error{"error"};
+            }
+            ++count;
+            return i;
+        });
+    };
+
+    std::vector<decltype(make(0))> senders;
+    for (int i = 0; i != 4; ++i) {
+        senders.push_back(make(i));
+    }
+
+    EXPECT_THROW(
+        this_thread::sync_wait(when_all_range(std::move(senders))),
+        std::runtime_error);
+
+    EXPECT_EQ(0, count.load());
+}
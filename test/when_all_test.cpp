@@ -9,6 +9,8 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <stdexcept>
 #include <string>
 
 using namespace std::chrono_literals;
@@ -107,3 +109,35 @@ TEST(when_all, thread_pool)
     EXPECT_EQ('X', r1);
     EXPECT_EQ(100.0, r2);
 }
+
+TEST(when_all, nested)
+{
+    auto [r0, r1, r2] = *this_thread::sync_wait(when_all(
+        when_all(just(1), just('X')),
+        just(2.0)
+    ));
+
+    EXPECT_EQ(1, r0);
+    EXPECT_EQ('X', r1);
+    EXPECT_EQ(2.0, r2);
+}
+
+TEST(when_all, cancellation)
+{
+    timed_thread_pool pool {2};
+
+    auto sched = pool.get_scheduler();
+
+    std::atomic<int> count = 0;
+
+    auto s = when_all(
+        schedule(sched) | then([] {
+            throw std::runtime_error{"error"};
+        }),
+        schedule_after(sched, 100ms) | then([&] { ++count; }),
+        schedule_after(sched, 100ms) | then([&] { ++count; })
+    );
+
+    EXPECT_THROW(this_thread::sync_wait(std::move(s)), std::runtime_error);
+    EXPECT_EQ(0, count.load());
+}